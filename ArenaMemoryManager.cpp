@@ -0,0 +1,138 @@
+/*
+ * File:    ArenaMemoryManager.cpp
+ * Author:  Conor Finegan
+ * Contact: conor_finegan@student.uml.edu
+ *
+ * Created on October 17, 2026
+ */
+
+#include "ArenaMemoryManager.h"
+
+#include <new>
+
+using namespace std;
+XERCES_CPP_NAMESPACE_USE
+
+namespace
+{
+    /**
+     * Every allocation is aligned for any type, as operator new's are.
+     */
+    constexpr size_t alignment = alignof(max_align_t);
+    
+    /**
+     * @param size Number of bytes.
+     * @return \c size rounded up to a multiple of \c alignment, and at least
+     *      \c alignment, so that every allocation has its own address.
+     */
+    size_t Align(const size_t size)
+    {
+        return (size == 0) ? alignment : 
+                (size + alignment - 1) & ~(alignment - 1);
+    }
+}
+
+constexpr std::size_t ArenaMemoryManager::DEFAULT_BLOCK_SIZE;
+
+ArenaMemoryManager::ArenaMemoryManager(const std::size_t block_size)
+        : block_size(Align(block_size))
+{
+}
+
+ArenaMemoryManager::~ArenaMemoryManager() noexcept
+{
+    for (const Block& block : blocks)
+    {
+        ::operator delete(block.data);
+    }
+}
+
+MemoryManager* ArenaMemoryManager::getExceptionMemoryManager()
+{
+    return XMLPlatformUtils::fgMemoryManager;
+}
+
+void* ArenaMemoryManager::allocate(XMLSize_t size)
+{
+    const size_t aligned = Align(size);
+    
+    ++ usage.allocations;
+    usage.bytes_used += aligned;
+    
+    // Large allocations get a block of their own, so that the rest of the
+    //      current block isn't wasted
+    if (aligned > block_size / 2)
+    {
+        return NewBlock(aligned);
+    }
+    
+    // Start a new block when the current one is full
+    if (static_cast<size_t>(limit - cursor) < aligned)
+    {
+        cursor = NewBlock(block_size);
+        limit = cursor + block_size;
+    }
+    
+    void* memory = cursor;
+    cursor += aligned;
+    
+    return memory;
+}
+
+void ArenaMemoryManager::deallocate(void* p)
+{
+    // Nothing is freed until the arena is reset
+    if (p) { ++ usage.deallocations; }
+}
+
+void ArenaMemoryManager::Reset()
+{
+    // Keep the first block if it is a standard one, as the next document
+    //      will need it anyway
+    const bool keep_first = !blocks.empty() && blocks.front().size == block_size;
+    
+    for (size_t i = keep_first ? 1 : 0; i < blocks.size(); ++ i)
+    {
+        ::operator delete(blocks[i].data);
+    }
+    
+    blocks.resize(keep_first ? 1 : 0);
+    
+    usage = Usage();
+    usage.blocks = blocks.size();
+    usage.bytes_reserved = keep_first ? block_size : 0;
+    
+    cursor = keep_first ? blocks.front().data : nullptr;
+    limit = keep_first ? cursor + block_size : nullptr;
+}
+
+ArenaMemoryManager::Usage ArenaMemoryManager::GetUsage() const
+{
+    return usage;
+}
+
+char* ArenaMemoryManager::NewBlock(const std::size_t size)
+{
+    char* data = nullptr;
+    
+    try
+    {
+        // Make room for the record first, so that a block is never obtained
+        //      without being recorded
+        blocks.reserve(blocks.size() + 1);
+        data = static_cast<char*>(::operator new(size));
+    }
+    
+    // Xerces-C expects its own exception from memory managers
+    catch (const std::bad_alloc&)
+    {
+        throw OutOfMemoryException();
+    }
+    
+    blocks.push_back(Block{ data, size });
+    
+    ++ usage.blocks;
+    usage.bytes_reserved += size;
+    
+    return data;
+}
@@ -0,0 +1,174 @@
+/*
+ * File:    ArenaMemoryManager.h
+ * Author:  Conor Finegan
+ * Contact: conor_finegan@student.uml.edu
+ *
+ * Created on October 17, 2026
+ */
+
+#ifndef ARENAMEMORYMANAGER_H
+#define	ARENAMEMORYMANAGER_H
+
+#include <xercesc/framework/MemoryManager.hpp>
+#include <xercesc/util/PlatformUtils.hpp>
+#include <xercesc/util/OutOfMemoryException.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * The \c ArenaMemoryManager class is a Xerces-C memory manager that carves
+ *      allocations out of large blocks, one after the other, and never frees
+ *      anything individually. Allocation is a pointer increment, and a
+ *      document built in the arena is freed all at once by Reset() after the
+ *      document has been released. This suits the program's build-then-write
+ *      use of documents, where nodes are rarely removed. The arena is not
+ *      thread-safe; give each thread's documents their own arena.
+ * @author Conor Finegan<br>conor_finegan@student.uml.edu
+ * @version 1.0
+ */
+class ArenaMemoryManager final : public XERCES_CPP_NAMESPACE::MemoryManager
+{
+public:
+    
+    /**
+     * Memory use of the arena.
+     */
+    struct Usage
+    {
+        /** Number of calls to allocate() since the last Reset(). */
+        std::uint64_t allocations = 0;
+        
+        /** Number of calls to deallocate() since the last Reset(). */
+        std::uint64_t deallocations = 0;
+        
+        /** Bytes handed out since the last Reset(), including padding. */
+        std::size_t bytes_used = 0;
+        
+        /** Bytes held in blocks obtained from the global heap. */
+        std::size_t bytes_reserved = 0;
+        
+        /** Number of blocks obtained from the global heap. */
+        std::size_t blocks = 0;
+    };
+    
+    /**
+     * Default size of the blocks requested from the global heap.
+     */
+    static constexpr std::size_t DEFAULT_BLOCK_SIZE = 1024 * 1024;
+    
+    /**
+     * Constructs an empty arena. No memory is reserved until the first
+     *      allocation.
+     * @param block_size Size of the blocks requested from the global heap.
+     *      Larger allocations get a block of their own.
+     */
+    explicit ArenaMemoryManager(
+            const std::size_t block_size = DEFAULT_BLOCK_SIZE);
+    
+    /**
+     * Disabled copy constructor \n
+     * Copying is disabled because the arena owns its blocks.
+     */
+    ArenaMemoryManager(const ArenaMemoryManager&) = delete;
+    
+    /**
+     * Disabled copy-assignment operator \n
+     * Copying is disabled because the arena owns its blocks.
+     */
+    void operator=(const ArenaMemoryManager&) = delete;
+    
+    /**
+     * Destructor \n
+     * Returns every block to the global heap. Nothing allocated from the
+     *      arena may be used afterwards.
+     */
+    ~ArenaMemoryManager() noexcept;
+    
+    /**
+     * Exceptions can outlive the objects that threw them, so they are
+     *      allocated from the global memory manager rather than the arena.
+     * @return \c XMLPlatformUtils::fgMemoryManager
+     */
+    XERCES_CPP_NAMESPACE::MemoryManager* getExceptionMemoryManager() override;
+    
+    /**
+     * Allocates memory from the current block, starting a new block if it is
+     *      full.
+     * @param size Number of bytes to allocate.
+     * @return Memory aligned for any type.
+     * @throw OutOfMemoryException If a new block can't be obtained.
+     */
+    void* allocate(XMLSize_t size) override;
+    
+    /**
+     * Does nothing but count the call; memory is only reclaimed by Reset().
+     * @param p Memory previously returned by allocate().
+     */
+    void deallocate(void* p) override;
+    
+    /**
+     * Reclaims everything allocated from the arena. The first block is kept
+     *      for reuse, the rest are returned to the global heap. Every object
+     *      allocated from the arena (such as a document created with it)
+     *      must have been released first.
+     */
+    void Reset();
+    
+    /**
+     * @return The current memory use of the arena.
+     */
+    Usage GetUsage() const;
+    
+private:
+    
+    /**
+     * A block of memory obtained from the global heap.
+     */
+    struct Block
+    {
+        /** Start of the block. */
+        char* data;
+        
+        /** Size of the block in bytes. */
+        std::size_t size;
+    };
+    
+    /**
+     * Obtains a block from the global heap and records it in \c blocks.
+     * @param size Size of the block in bytes.
+     * @return The start of the block.
+     * @throw OutOfMemoryException If the block can't be obtained.
+     */
+    char* NewBlock(const std::size_t size);
+    
+    /**
+     * Size of the blocks requested from the global heap.
+     */
+    const std::size_t block_size;
+    
+    /**
+     * Every block obtained from the global heap, in order.
+     */
+    std::vector<Block> blocks;
+    
+    /**
+     * Next free byte in the current block.
+     */
+    char* cursor = nullptr;
+    
+    /**
+     * End of the current block.
+     */
+    char* limit = nullptr;
+    
+    /**
+     * Memory use since the last Reset(). \c bytes_reserved and \c blocks are
+     *      kept up to date as blocks come and go.
+     */
+    Usage usage;
+};
+
+#endif	/* ARENAMEMORYMANAGER_H */
+
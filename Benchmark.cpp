@@ -0,0 +1,125 @@
+/*
+ * File:    Benchmark.cpp
+ * Author:  Conor Finegan
+ * Contact: conor_finegan@student.uml.edu
+ *
+ * Created on October 17, 2026
+ */
+
+#include "Benchmark.h"
+
+#include <algorithm>
+#include <chrono>
+
+using namespace std;
+
+namespace
+{
+    /**
+     * Round-trips each of \c strings through \c XStr and \c LocalStr until
+     *      \c iterations round trips have been made.
+     * @param name       Name of the benchmark.
+     * @param strings    Strings to transcode, used in turn.
+     * @param iterations Number of round trips.
+     * @return The measurements.
+     */
+    Benchmark::Result TimeRoundTrips(const char* name, 
+            const vector<string>& strings, const size_t iterations)
+    {
+        // Keeps the optimizer from discarding the conversions
+        volatile char sink = 0;
+        
+        const auto start = chrono::steady_clock::now();
+        
+        for (size_t i = 0; i < iterations; ++ i)
+        {
+            XStr unicode(strings[i % strings.size()]);
+            LocalStr local(unicode.get_unicode_form());
+            sink = sink + local.get_local_form()[0];
+        }
+        
+        Benchmark::Result result;
+        result.name = name;
+        result.operations = 2 * static_cast<uint64_t>(iterations);
+        result.seconds = chrono::duration<double>(
+                chrono::steady_clock::now() - start).count();
+        
+        return result;
+    }
+}
+
+double Benchmark::Result::PerSecond() const
+{
+    return (seconds > 0.0) ? operations / seconds : 0.0;
+}
+
+std::vector<Benchmark::Result> Benchmark::Transcode(const std::size_t iterations)
+{
+    // Typical element and attribute names
+    const vector<string> names = 
+    {
+        "book", "author", "title", "publication_date", "isbn", "id"
+    };
+    
+    // Content too long for the internal buffers
+    const vector<string> text = { string(4 * XStr::SMALL_CAPACITY, 'x') };
+    
+    return vector<Result>
+    {
+        TimeRoundTrips("transcode (short names)", names, iterations),
+        TimeRoundTrips("transcode (long text)", text, iterations)
+    };
+}
+
+std::vector<Benchmark::Result> Benchmark::Strings(const std::size_t line_length,
+        const std::size_t iterations)
+{
+    // A quarter of padding at each end, and words in between
+    const size_t padding = line_length / 4;
+    string line(padding, ' ');
+    
+    while (line.size() + padding < line_length)
+    {
+        line += "word ";
+    }
+    
+    line.append(line_length - min(line.size(), line_length), ' ');
+    
+    const uint64_t characters = static_cast<uint64_t>(line.size()) * iterations;
+    
+    // Keeps the optimizer from discarding the results
+    volatile size_t sink = 0;
+    
+    Result trim;
+    trim.name = "trim (padded line)";
+    trim.operations = characters;
+    
+    auto start = chrono::steady_clock::now();
+    
+    for (size_t i = 0; i < iterations; ++ i)
+    {
+        sink = sink + jmhUtilities::trim(line).size();
+    }
+    
+    trim.seconds = chrono::duration<double>(
+            chrono::steady_clock::now() - start).count();
+    
+    Result split;
+    split.name = "split (long line)";
+    split.operations = characters;
+    
+    // Reuse the token vector, as Output2ColumnTable does
+    vector<string> tokens;
+    start = chrono::steady_clock::now();
+    
+    for (size_t i = 0; i < iterations; ++ i)
+    {
+        jmhUtilities::StringSplit(line, ' ', tokens);
+        sink = sink + tokens.size();
+    }
+    
+    split.seconds = chrono::duration<double>(
+            chrono::steady_clock::now() - start).count();
+    
+    return vector<Result>{ trim, split };
+}
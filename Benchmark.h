@@ -0,0 +1,85 @@
+/*
+ * File:    Benchmark.h
+ * Author:  Conor Finegan
+ * Contact: conor_finegan@student.uml.edu
+ *
+ * Created on October 17, 2026
+ */
+
+#ifndef BENCHMARK_H
+#define	BENCHMARK_H
+
+#include "XStr.h"
+#include "LocalStr.h"
+#include "jmhUtilities.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * The \c Benchmark class holds micro-benchmarks for the hot paths of the
+ *      program, so that the effect of a change can be measured from the
+ *      command line.
+ * @author Conor Finegan<br>conor_finegan@student.uml.edu
+ * @version 1.0
+ */
+class Benchmark final
+{
+public:
+    
+    /**
+     * Measurements from a single benchmark.
+     */
+    struct Result
+    {
+        /** Name of the benchmark. */
+        std::string name;
+        
+        /** Number of operations performed. */
+        std::uint64_t operations = 0;
+        
+        /** Time taken to perform them, in seconds. */
+        double seconds = 0.0;
+        
+        /**
+         * @return The number of operations per second, or zero if no time
+         *      was measured.
+         */
+        double PerSecond() const;
+    };
+    
+    /**
+     * Measures transcoding through \c XStr and \c LocalStr, the classes
+     *      behind \c XSTR and \c LSTR. Each iteration converts a name to
+     *      Unicode and back, which counts as two transcodes. Short element
+     *      names (which fit in the objects' internal buffers) and long text
+     *      (which does not) are measured separately.
+     * @param iterations Number of round trips for each kind of string.
+     * @return One result for short names, then one for long text.
+     */
+    static std::vector<Result> Transcode(const std::size_t iterations);
+    
+    /**
+     * Measures \c jmhUtilities::trim and \c jmhUtilities::StringSplit on a
+     *      long line of short words, padded with white space at both ends.
+     *      Operations are counted in characters of input.
+     * @param line_length Length of the line, in characters.
+     * @param iterations  Number of times each function is called.
+     * @return One result for trim, then one for StringSplit.
+     */
+    static std::vector<Result> Strings(const std::size_t line_length,
+            const std::size_t iterations);
+    
+private:
+    
+    /**
+     * Construction of \c Benchmark objects is prohibited, as this class
+     *      contains only static data.
+     */
+    Benchmark() = delete;
+};
+
+#endif	/* BENCHMARK_H */
+
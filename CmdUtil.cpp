@@ -13,8 +13,10 @@ using namespace std;
 bool CmdUtil::YesNoPrompt(const std::string& message)
 {
     constexpr char KEY_PROMPT[] = " (y/n) ";
-    regex reYesCommand("^\\s*y(es)?\\s*$", regex::icase);
-    regex reNoCommand("^\\s*no?\\s*$", regex::icase);
+    
+    // Compiled once, on the first call to this method
+    static const regex reYesCommand("^\\s*y(es)?\\s*$", regex::icase);
+    static const regex reNoCommand("^\\s*no?\\s*$", regex::icase);
     
     cout << message << KEY_PROMPT;
     
@@ -51,32 +53,41 @@ bool CmdUtil::YesNoPrompt(const std::string& message)
 void CmdUtil::Output2ColumnTable(
         const std::vector<std::string>& left_strings,
         const std::vector<std::string>& right_strings,
-        size_t left_width, size_t right_width)
+        size_t left_width, size_t right_width, std::ostream& out)
 {
     // Initialize iterators for left and right sides
     auto litr = left_strings.begin(), lend = left_strings.end();
     auto ritr = right_strings.begin(), rend = right_strings.end();   
     
+    // Token vectors are reused from row to row, so that their memory is only
+    //      allocated once
+    vector<string> left_toks, right_toks;
+    
     // While there are still strings
     while (litr != lend || ritr != rend)
     {
-        // Vector inputs for helper function default to empty
-        vector<string> left_toks, right_toks;
-        
-        // Fill left vector if there are mores strings
+        // Fill left vector if there are mores strings, otherwise leave it empty
         if (litr != lend)
         {
-            left_toks = jmhUtilities::StringSplit(*litr, ' ');
+            jmhUtilities::StringSplit(*litr, ' ', left_toks);
+        }
+        else
+        {
+            left_toks.clear();
         }
         
-        // Fill right vector if there are more strings
+        // Fill right vector if there are more strings, otherwise leave it empty
         if (ritr != rend)
         {
-            right_toks = jmhUtilities::StringSplit(*ritr, ' ');
+            jmhUtilities::StringSplit(*ritr, ' ', right_toks);
+        }
+        else
+        {
+            right_toks.clear();
         }
         
         // Helper function to output this row
-        OutputTableRow(left_toks, right_toks, left_width, right_width);
+        OutputTableRow(left_toks, right_toks, left_width, right_width, out);
         
         // Increment iterators
         if (litr != lend) { ++ litr; }
@@ -86,7 +97,7 @@ void CmdUtil::Output2ColumnTable(
 
 void CmdUtil::OutputTableRow(const std::vector<std::string>& left_vec, 
         const std::vector<std::string>& right_vec, 
-        size_t left_width, size_t right_width)
+        size_t left_width, size_t right_width, std::ostream& out)
 {
     // Error message that fires if any of the tokens processed are too long
     //      to fit in their respective columns.
@@ -114,7 +125,7 @@ void CmdUtil::OutputTableRow(const std::vector<std::string>& left_vec,
             }
             
             // Output token and increase size/increment
-            cout << *litr << ' ';
+            out << *litr << ' ';
             lpos += litr->size() + 1;
             ++ litr;
         }
@@ -122,7 +133,7 @@ void CmdUtil::OutputTableRow(const std::vector<std::string>& left_vec,
         // Fill rest of left column with white space
         while (lpos  <= left_width)
         {
-            cout << ' ';
+            out << ' ';
             ++ lpos;
         }
         
@@ -137,7 +148,7 @@ void CmdUtil::OutputTableRow(const std::vector<std::string>& left_vec,
             }
             
             // Output token and increase size/increment
-            cout << *ritr << ' ';
+            out << *ritr << ' ';
             rpos += ritr->size() + 1;
             ++ ritr;
         }
@@ -145,6 +156,6 @@ void CmdUtil::OutputTableRow(const std::vector<std::string>& left_vec,
         // Reset counters and go to next line
         lpos = 0;
         rpos = 0;
-        cout << endl;
+        out << endl;
     }
 }
\ No newline at end of file
@@ -45,7 +45,7 @@ public:
     static bool YesNoPrompt(const std::string& message);
     
     /**
-     * Output a formatted 2-column table to standard out. This function will
+     * Output a formatted 2-column table to a stream. This function will
      *      automatically provides formatting so that words don't incorrectly
      *      wrap around to the next line. Note that the behavior of this
      *      function if it encounters a word longer than its column length
@@ -54,12 +54,14 @@ public:
      * @param right_strings vector of strings to display on the RHS
      * @param left_width    width of the LHS column
      * @param right_width   width of the RHS column
+     * @param out           stream to print to; standard out by default
      * @throw \c std::runtime_exception (from \c OutputTableRow If the method 
      *      encounters a string too long to format.
      */
     static void Output2ColumnTable(const std::vector<std::string>& left_strings,
             const std::vector<std::string>& right_strings, 
-            const size_t left_width, const size_t right_width);
+            const size_t left_width, const size_t right_width,
+            std::ostream& out = std::cout);
         
     /**
      * Most errors in C++ stream system are not considered critical failures,
@@ -95,13 +97,14 @@ private:
      * @param right_vec   string tokens to print on RHS
      * @param left_width  width of the LHS column
      * @param right_width width of the RHS column
+     * @param out         stream to print to
      * @throw \c std::runtime_exception If the method encounters a string too
      *      long to format.
      */
     static void OutputTableRow( 
             const std::vector<std::string>& left_vec, 
             const std::vector<std::string>& right_vec, 
-            size_t left_width, size_t right_width);
+            size_t left_width, size_t right_width, std::ostream& out);
 };
 
 #endif	/* CMDUTIL_H */
@@ -0,0 +1,171 @@
+/*
+ * File:    CommandGrammar.cpp
+ * Author:  Conor Finegan
+ * Contact: conor_finegan@student.uml.edu
+ *
+ * Created on October 17, 2026
+ */
+
+#include "CommandGrammar.h"
+
+#include <cctype>
+#include <cstring>
+
+using namespace std;
+
+constexpr size_t CommandGrammar::MAX_TOKENS;
+
+const CommandGrammar& CommandGrammar::Instance()
+{
+    // Built on first use, then shared for the life of the process
+    static const CommandGrammar grammar;
+    return grammar;
+}
+
+CommandGrammar::CommandGrammar() : keywords({
+    { "add",        Keyword::Add        },
+    { "print",      Keyword::Print      },
+    { "write",      Keyword::Write      },
+    { "help",       Keyword::Help       },
+    { "delete",     Keyword::Delete     },
+    { "del",        Keyword::Delete     },
+    { "quit",       Keyword::Quit       },
+    { "exit",       Keyword::Quit       },
+    { "element",    Keyword::Element    },
+    { "attribute",  Keyword::Attribute  },
+    { "elements",   Keyword::Elements   },
+    { "attributes", Keyword::Attributes },
+    { "lookup",     Keyword::Lookup     },
+    { "load",       Keyword::Load       },
+    { "stream",     Keyword::Stream     },
+    { "bench",      Keyword::Bench      },
+    { "cache",      Keyword::Cache      },
+    { "memory",     Keyword::Memory     },
+    { "jobs",       Keyword::Jobs       },
+    { "wait",       Keyword::Wait       },
+    { "verbosity",  Keyword::Verbosity  },
+    { "stats",      Keyword::Stats      },
+    { "new",        Keyword::New        },
+    { "use",        Keyword::Use        },
+    { "close",      Keyword::Close      },
+    { "docs",       Keyword::Docs       }
+})
+{
+}
+
+void CommandGrammar::Tokenize(const std::string& line, TokenList& tokens)
+{
+    const char* pos = line.data();
+    const char* const end = pos + line.size();
+
+    tokens.count = 0;
+
+    while (pos != end)
+    {
+        // Skip white-space between tokens
+        if (isspace(static_cast<unsigned char>(*pos)))
+        {
+            ++ pos;
+            continue;
+        }
+
+        // Consume the token
+        const char* const start = pos;
+        while (pos != end && !isspace(static_cast<unsigned char>(*pos)))
+        {
+            ++ pos;
+        }
+
+        // Only store as many tokens as there is room for, but keep counting
+        //      so that the caller can tell the line had too many arguments
+        if (tokens.count < MAX_TOKENS)
+        {
+            tokens.tokens[tokens.count] = Token{ start,
+                    static_cast<size_t>(pos - start) };
+        }
+        ++ tokens.count;
+    }
+}
+
+CommandGrammar::Keyword CommandGrammar::Lookup(const Token& token) const
+{
+    for (const KeywordEntry& entry : keywords)
+    {
+        if (EqualsIgnoreCase(token, entry.spelling))
+        {
+            return entry.keyword;
+        }
+    }
+
+    return Keyword::Unknown;
+}
+
+const char* CommandGrammar::Spelling(const Keyword keyword) const
+{
+    // The main spelling of each keyword comes before its synonyms
+    for (const KeywordEntry& entry : keywords)
+    {
+        if (entry.keyword == keyword)
+        {
+            return entry.spelling;
+        }
+    }
+
+    return "unknown";
+}
+
+bool CommandGrammar::IsWord(const Token& token)
+{
+    if (token.length == 0) { return false; }
+
+    for (size_t i = 0; i < token.length; ++ i)
+    {
+        const unsigned char c = token.text[i];
+        if (!isalnum(c) && c != '_') { return false; }
+    }
+
+    return true;
+}
+
+bool CommandGrammar::IsAddress(const Token& token)
+{
+    if (IsWord(token)) { return true; }
+
+    // A lone '*' is a one-step path that matches every element
+    if (token.length == 1 && token.text[0] == '*') { return true; }
+
+    return token.length > 0 && (token.text[0] == '/' ||
+            memchr(token.text, '[', token.length) != nullptr);
+}
+
+bool CommandGrammar::IsFileName(const Token& token)
+{
+    if (token.length == 0) { return false; }
+
+    for (size_t i = 0; i < token.length; ++ i)
+    {
+        const unsigned char c = token.text[i];
+        if (!isalnum(c) && c != '_' && c != '.') { return false; }
+    }
+
+    return true;
+}
+
+bool CommandGrammar::IsRootSpecifier(const Token& token)
+{
+    return EqualsIgnoreCase(token, "root");
+}
+
+bool CommandGrammar::EqualsIgnoreCase(const Token& token, const char* lower)
+{
+    // Cheap length check first; most tokens are not keywords
+    if (strlen(lower) != token.length) { return false; }
+
+    for (size_t i = 0; i < token.length; ++ i)
+    {
+        const unsigned char c = token.text[i];
+        if (tolower(c) != lower[i]) { return false; }
+    }
+
+    return true;
+}
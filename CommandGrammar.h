@@ -0,0 +1,247 @@
+/*
+ * File:    CommandGrammar.h
+ * Author:  Conor Finegan
+ * Contact: conor_finegan@student.uml.edu
+ *
+ * Created on October 17, 2026
+ */
+
+#ifndef COMMANDGRAMMAR_H
+#define	COMMANDGRAMMAR_H
+
+#include <array>
+#include <cassert>
+#include <string>
+#include <vector>
+
+/**
+ * The \c CommandGrammar class describes the command language understood by
+ *      \c InputParser. A command line is split into whitespace-delimited
+ *      tokens in a single pass by Tokenize(), without allocating, and the
+ *      leading tokens are identified through a case-insensitive keyword
+ *      table. The keyword table is built once per process and shared by
+ *      every parser through Instance().
+ * @author Conor Finegan<br>conor_finegan@student.uml.edu
+ * @version 2.0
+ */
+class CommandGrammar final
+{
+public:
+
+    /**
+     * Every keyword recognized by the grammar. \c Unknown is returned by
+     *      Lookup() for any token that is not a keyword.
+     */
+    enum class Keyword
+    {
+        Unknown,
+        Add,
+        Print,
+        Write,
+        Help,
+        Delete,
+        Quit,
+        Element,
+        Attribute,
+        Elements,
+        Attributes,
+        Lookup,
+        Load,
+        Stream,
+        Bench,
+        Cache,
+        Memory,
+        Jobs,
+        Wait,
+        Verbosity,
+        Stats,
+        New,
+        Use,
+        Close,
+        Docs
+    };
+
+    /**
+     * A single token of a command line. The token does not own its text; it
+     *      refers to a range inside the line passed to Tokenize(), so it is
+     *      only valid for as long as that line is.
+     */
+    struct Token
+    {
+        /** First character of the token. */
+        const char* text;
+
+        /** Number of characters in the token. */
+        size_t length;
+
+        /**
+         * Creates an owning copy of the token's text.
+         * @return The token as an \c std::string.
+         */
+        std::string str() const { return std::string(text, length); }
+    };
+
+    /**
+     * Maximum number of tokens stored for a single command line. No command
+     *      in the grammar takes anywhere near this many arguments.
+     */
+    static constexpr size_t MAX_TOKENS = 16;
+
+    /**
+     * Fixed-capacity list of the tokens found on a command line. If a line
+     *      holds more than \c MAX_TOKENS tokens, size() still reports the true
+     *      count (so that argument-count checks fail as expected), but only
+     *      the first \c MAX_TOKENS are stored.
+     */
+    class TokenList
+    {
+    public:
+
+        /**
+         * @return The number of tokens found on the line.
+         */
+        size_t size() const { return count; }
+
+        /**
+         * @return \c true if the line contained no tokens.
+         */
+        bool empty() const { return count == 0; }
+
+        /**
+         * Accessor for a stored token.
+         * @param index Position of the token; must be less than both size()
+         *      and \c MAX_TOKENS.
+         * @return The token at position \c index.
+         */
+        const Token& operator[](size_t index) const
+        {
+            assert(index < count && index < MAX_TOKENS);
+            return tokens[index];
+        }
+
+    private:
+        friend class CommandGrammar;
+
+        /** Storage for the first \c MAX_TOKENS tokens. */
+        std::array<Token, MAX_TOKENS> tokens;
+
+        /** Total number of tokens found, including any that weren't stored. */
+        size_t count = 0;
+    };
+
+    /**
+     * Accessor for the process-wide grammar. The grammar is constructed on
+     *      first use; initialization of the function-local static is
+     *      thread-safe as of C++11.
+     * @return Reference to the shared grammar.
+     */
+    static const CommandGrammar& Instance();
+
+    /**
+     * Disabled copy constructor \n
+     * There is only ever one grammar, shared through Instance().
+     */
+    CommandGrammar(const CommandGrammar&) = delete;
+
+    /**
+     * Disabled copy-assignment operator \n
+     * There is only ever one grammar, shared through Instance().
+     */
+    void operator=(const CommandGrammar&) = delete;
+
+    /**
+     * Splits a command line into whitespace-delimited tokens in a single
+     *      linear scan. No memory is allocated; the tokens refer directly
+     *      into \c line.
+     * @param line   The command line to split. Must outlive \c tokens.
+     * @param tokens Receives the tokens found on the line.
+     */
+    static void Tokenize(const std::string& line, TokenList& tokens);
+
+    /**
+     * Identifies a token as a keyword. The comparison is not case-sensitive.
+     * @param token The token to identify.
+     * @return The matching keyword, or \c Keyword::Unknown.
+     */
+    Keyword Lookup(const Token& token) const;
+
+    /**
+     * The reverse of Lookup(): finds how a keyword is spelled.
+     * @param keyword The keyword to spell.
+     * @return The main spelling of the keyword (e.g. "delete" rather than
+     *      "del"), or "unknown" for \c Keyword::Unknown.
+     */
+    const char* Spelling(const Keyword keyword) const;
+
+    /**
+     * Checks that a token is a valid name, i.e. one or more word characters
+     *      (letters, digits and underscores).
+     * @param token The token to check.
+     * @return \c true if the token is a valid name.
+     */
+    static bool IsWord(const Token& token);
+
+    /**
+     * Checks that a token can address elements, i.e. that it is either a
+     *      valid name (see IsWord()) or a path: one that starts with '/',
+     *      contains a predicate in square brackets, or is a lone '*'
+     *      matching every element. Only the form is checked
+     *      here; the path is compiled by \c NodePath when it is used.
+     * @param token The token to check.
+     * @return \c true if the token is a name or a path.
+     */
+    static bool IsAddress(const Token& token);
+
+    /**
+     * Checks that a token is a valid file name for the "write" command, i.e.
+     *      one or more word characters or periods.
+     * @param token The token to check.
+     * @return \c true if the token is a valid file name.
+     */
+    static bool IsFileName(const Token& token);
+
+    /**
+     * Checks for the special parent name "root" (not case-sensitive), used by
+     *      "add element" to specify the root of the document.
+     * @param token The token to check.
+     * @return \c true if the token names the root.
+     */
+    static bool IsRootSpecifier(const Token& token);
+    
+    /**
+     * Compares a token against a lower-case word without regard to case.
+     *      Used for option words that are not keywords in their own right.
+     * @param token The token to compare.
+     * @param lower Lower-case, null-terminated word.
+     * @return \c true if the token spells \c lower.
+     */
+    static bool EqualsIgnoreCase(const Token& token, const char* lower);
+
+private:
+
+    /**
+     * Entry in the keyword table.
+     */
+    struct KeywordEntry
+    {
+        /** Lower-case spelling of the keyword. */
+        const char* spelling;
+
+        /** Keyword identified by the spelling. */
+        Keyword keyword;
+    };
+
+    /**
+     * Builds the keyword table. Only called by Instance().
+     */
+    CommandGrammar();
+
+    /**
+     * Every spelling of every keyword. "del" and "exit" are accepted as
+     *      synonyms for "delete" and "quit" respectively.
+     */
+    const std::vector<KeywordEntry> keywords;
+};
+
+#endif	/* COMMANDGRAMMAR_H */
+
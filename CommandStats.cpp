@@ -0,0 +1,231 @@
+/*
+ * File:    CommandStats.cpp
+ * Author:  Conor Finegan
+ * Contact: conor_finegan@student.uml.edu
+ *
+ * Created on October 17, 2026
+ */
+
+#include "CommandStats.h"
+
+#include <cassert>
+#include <iomanip>
+#include <sstream>
+
+using namespace std;
+
+constexpr std::size_t CommandStats::BUCKETS;
+constexpr std::size_t CommandStats::MAX_COMMANDS;
+constexpr std::size_t CommandStats::OPERATIONS;
+
+void CommandStats::Counter::Record(const std::uint64_t nanoseconds)
+{
+    ++ calls;
+    total_ns += nanoseconds;
+
+    if (nanoseconds > max_ns) { max_ns = nanoseconds; }
+
+    // The bucket is the position of the highest bit that is set
+    size_t bucket = 0;
+    for (uint64_t rest = nanoseconds >> 1; rest != 0; rest >>= 1)
+    {
+        ++ bucket;
+    }
+
+    ++ histogram[(bucket < BUCKETS) ? bucket : BUCKETS - 1];
+}
+
+std::uint64_t CommandStats::Counter::Percentile(const double fraction) const
+{
+    const double target = fraction * calls;
+    uint64_t seen = 0;
+
+    for (size_t i = 0; i < BUCKETS; ++ i)
+    {
+        seen += histogram[i];
+
+        if (seen > 0 && seen >= target)
+        {
+            const uint64_t upper = uint64_t(1) << (i + 1);
+            return (upper < max_ns) ? upper : max_ns;
+        }
+    }
+
+    return max_ns;
+}
+
+CommandStats::Counter& CommandStats::ForCommand(
+        const CommandGrammar::Keyword keyword)
+{
+    const size_t index = static_cast<size_t>(keyword);
+    assert(index < MAX_COMMANDS);
+
+    return commands[index];
+}
+
+CommandStats::Counter& CommandStats::ForOperation(const Operation operation)
+{
+    return operations[static_cast<size_t>(operation)];
+}
+
+void CommandStats::Clear()
+{
+    commands.fill(Counter());
+    operations.fill(Counter());
+}
+
+void CommandStats::Report(std::ostream& out) const
+{
+    const CommandGrammar& grammar = CommandGrammar::Instance();
+
+    // Format separately, so that the stream's flags are untouched
+    ostringstream table;
+    table << left << setw(12) << "Name" << right << setw(10) << "Calls"
+            << setw(12) << "Total" << setw(12) << "Mean" << setw(12) << "Max"
+            << setw(12) << "~Median" << setw(12) << "~99%" << "\n";
+
+    const auto row = [&table](const char* name, const Counter& counter)
+    {
+        table << left << setw(12) << name << right << setw(10)
+                << counter.calls << setw(12) << FormatTime(counter.total_ns)
+                << setw(12) << FormatTime(counter.total_ns / counter.calls)
+                << setw(12) << FormatTime(counter.max_ns)
+                << setw(12) << FormatTime(counter.Percentile(0.5))
+                << setw(12) << FormatTime(counter.Percentile(0.99)) << "\n";
+    };
+
+    bool any = false;
+
+    for (size_t i = 0; i < MAX_COMMANDS; ++ i)
+    {
+        if (commands[i].calls > 0)
+        {
+            row(grammar.Spelling(static_cast<CommandGrammar::Keyword>(i)),
+                    commands[i]);
+            any = true;
+        }
+    }
+
+    for (size_t i = 0; i < OPERATIONS; ++ i)
+    {
+        if (operations[i].calls > 0)
+        {
+            // Operations are told apart from commands (such as "lookup") by
+            //      a leading '+'
+            row(("+" + string(OperationName(static_cast<Operation>(i))))
+                    .c_str(), operations[i]);
+            any = true;
+        }
+    }
+
+    if (!any)
+    {
+        out << "No commands have been run." << endl;
+        return;
+    }
+
+    out << table.str() << flush;
+}
+
+bool CommandStats::ReportHistogram(const std::string& name,
+        std::ostream& out) const
+{
+    const Counter* counter = nullptr;
+
+    for (size_t i = 0; i < OPERATIONS && !counter; ++ i)
+    {
+        if (name == "+" + string(OperationName(static_cast<Operation>(i))))
+        {
+            counter = &operations[i];
+        }
+    }
+
+    if (!counter)
+    {
+        const CommandGrammar::Keyword keyword = CommandGrammar::Instance()
+                .Lookup(CommandGrammar::Token{ name.data(), name.size() });
+
+        if (keyword == CommandGrammar::Keyword::Unknown)
+        {
+            return false;
+        }
+
+        counter = &commands[static_cast<size_t>(keyword)];
+    }
+
+    if (counter->calls == 0)
+    {
+        out << "\"" << name << "\" has not been run." << endl;
+        return true;
+    }
+
+    // One line per bucket from the fastest call to the slowest, with a bar
+    //      scaled to the fullest bucket
+    size_t first = 0;
+    size_t last = BUCKETS - 1;
+    uint64_t fullest = 0;
+
+    while (counter->histogram[first] == 0) { ++ first; }
+    while (counter->histogram[last] == 0) { -- last; }
+
+    for (size_t i = first; i <= last; ++ i)
+    {
+        if (counter->histogram[i] > fullest)
+        {
+            fullest = counter->histogram[i];
+        }
+    }
+
+    ostringstream chart;
+
+    for (size_t i = first; i <= last; ++ i)
+    {
+        const uint64_t count = counter->histogram[i];
+        const size_t bar = static_cast<size_t>((count * 40 + fullest - 1) /
+                fullest);
+
+        chart << right << setw(10) << FormatTime(uint64_t(1) << i) << " - "
+                << left << setw(10) << FormatTime(uint64_t(1) << (i + 1))
+                << right << setw(10) << count << " " << string(bar, '#')
+                << "\n";
+    }
+
+    out << chart.str() << flush;
+    return true;
+}
+
+const char* CommandStats::OperationName(const Operation operation)
+{
+    switch (operation)
+    {
+        case Operation::Lookup:    return "lookup";
+        case Operation::Append:    return "append";
+        case Operation::Remove:    return "remove";
+        case Operation::Serialize: return "serialize";
+    }
+
+    return "unknown";
+}
+
+std::string CommandStats::FormatTime(const std::uint64_t nanoseconds)
+{
+    ostringstream text;
+
+    if (nanoseconds < 1000)
+    {
+        text << nanoseconds << " ns";
+    }
+
+    else
+    {
+        const char* unit = "us";
+        double value = nanoseconds / 1e3;
+
+        if (value >= 1e3) { value /= 1e3; unit = "ms"; }
+        if (value >= 1e3) { value /= 1e3; unit = "s"; }
+
+        text << fixed << setprecision(1) << value << " " << unit;
+    }
+
+    return text.str();
+}
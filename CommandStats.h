@@ -0,0 +1,220 @@
+/*
+ * File:    CommandStats.h
+ * Author:  Conor Finegan
+ * Contact: conor_finegan@student.uml.edu
+ *
+ * Created on October 17, 2026
+ */
+
+#ifndef COMMANDSTATS_H
+#define	COMMANDSTATS_H
+
+#include "CommandGrammar.h"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+/**
+ * The \c CommandStats class counts how often each command and each DOM
+ *      operation is performed, and how long they take. All of the counters
+ *      are allocated up front, and recording a measurement only updates a few
+ *      integers, so the statistics are cheap enough to keep all the time.
+ *      The counters are not synchronized; they must only be updated from the
+ *      thread that runs the commands.
+ * @author Conor Finegan<br>conor_finegan@student.uml.edu
+ * @version 1.0
+ */
+class CommandStats final
+{
+public:
+
+    /**
+     * Number of histogram buckets. Bucket \c i counts latencies of at least
+     *      2^i (and less than 2^(i+1)) nanoseconds; the last bucket also
+     *      counts anything longer.
+     */
+    static constexpr std::size_t BUCKETS = 40;
+
+    /**
+     * Highest number of keywords that can be counted.
+     */
+    static constexpr std::size_t MAX_COMMANDS = 64;
+
+    /**
+     * Measurements of one command or operation.
+     */
+    struct Counter
+    {
+        /** Number of times it was performed. */
+        std::uint64_t calls = 0;
+
+        /** Time taken by all of them together, in nanoseconds. */
+        std::uint64_t total_ns = 0;
+
+        /** Time taken by the slowest, in nanoseconds. */
+        std::uint64_t max_ns = 0;
+
+        /** Number of times it took each range of time. See \c BUCKETS. */
+        std::array<std::uint64_t, BUCKETS> histogram {};
+
+        /**
+         * Adds one measurement.
+         * @param nanoseconds Time it took.
+         */
+        void Record(const std::uint64_t nanoseconds);
+
+        /**
+         * Estimates a percentile of the latency from the histogram.
+         * @param fraction Fraction of calls, e.g. 0.99 for the 99th
+         *      percentile.
+         * @return The upper bound of the bucket holding the percentile, in
+         *      nanoseconds, but no more than \c max_ns.
+         */
+        std::uint64_t Percentile(const double fraction) const;
+    };
+
+    /**
+     * DOM operations that are measured separately from the commands that
+     *      perform them.
+     */
+    enum class Operation
+    {
+        /** Finding elements by name. */
+        Lookup,
+
+        /** Appending new elements to their parents. */
+        Append,
+
+        /** Removing and releasing a subtree. */
+        Remove,
+
+        /** Writing the document out with \c DocumentWriter. */
+        Serialize
+    };
+
+    /**
+     * Number of values in \c Operation.
+     */
+    static constexpr std::size_t OPERATIONS = 4;
+
+    /**
+     * Accessor for the counter of a command.
+     * @param keyword First keyword of the command.
+     * @return The counter, which stays valid for the life of the object.
+     */
+    Counter& ForCommand(const CommandGrammar::Keyword keyword);
+
+    /**
+     * Accessor for the counter of an operation.
+     * @param operation The operation.
+     * @return The counter, which stays valid for the life of the object.
+     */
+    Counter& ForOperation(const Operation operation);
+
+    /**
+     * Resets every counter to zero.
+     */
+    void Clear();
+
+    /**
+     * Prints a table of every command and operation that was performed at
+     *      least once: the number of calls, the total, mean and maximum time,
+     *      and the estimated median and 99th percentile.
+     * @param out Stream to print to.
+     */
+    void Report(std::ostream& out) const;
+
+    /**
+     * Prints the histogram of a single command or operation.
+     * @param name Name of the command (any spelling), or of the operation
+     *      preceded by '+' ("+lookup", "+append", "+remove" or
+     *      "+serialize"), as they are listed by Report().
+     * @param out  Stream to print to.
+     * @return \c false if \c name names neither.
+     */
+    bool ReportHistogram(const std::string& name, std::ostream& out) const;
+
+private:
+
+    /**
+     * @param operation An operation.
+     * @return Its name, e.g. "lookup".
+     */
+    static const char* OperationName(const Operation operation);
+
+    /**
+     * Formats a time for the reports, in the largest unit that keeps it at
+     *      or above 1 (ns, us, ms or s).
+     * @param nanoseconds Time to format.
+     * @return e.g. "1.5 ms".
+     */
+    static std::string FormatTime(const std::uint64_t nanoseconds);
+
+    /**
+     * Counters of the commands, indexed by keyword.
+     */
+    std::array<Counter, MAX_COMMANDS> commands;
+
+    /**
+     * Counters of the operations, indexed by \c Operation.
+     */
+    std::array<Counter, OPERATIONS> operations;
+};
+
+/**
+ * The \c ScopedTimer class measures the time from its construction to its
+ *      destruction, and records it in a counter of \c CommandStats.
+ * @author Conor Finegan<br>conor_finegan@student.uml.edu
+ * @version 1.0
+ */
+class ScopedTimer final
+{
+public:
+
+    /**
+     * Starts the timer.
+     * @param counter Counter that receives the measurement. Must outlive the
+     *      timer.
+     */
+    explicit ScopedTimer(CommandStats::Counter& counter) :
+            counter(counter), start(std::chrono::steady_clock::now())
+    {
+    }
+
+    /**
+     * Stops the timer and records the time taken.
+     */
+    ~ScopedTimer()
+    {
+        counter.Record(static_cast<std::uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start).count()));
+    }
+
+    /**
+     * Disabled copy constructor \n
+     * Each timer records exactly one measurement.
+     */
+    ScopedTimer(const ScopedTimer&) = delete;
+
+    /**
+     * Disabled copy-assignment operator \n
+     * Each timer records exactly one measurement.
+     */
+    void operator=(const ScopedTimer&) = delete;
+
+private:
+
+    /** Counter that receives the measurement. */
+    CommandStats::Counter& counter;
+
+    /** When the timer was started. */
+    const std::chrono::steady_clock::time_point start;
+};
+
+#endif	/* COMMANDSTATS_H */
+
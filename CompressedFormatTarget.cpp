@@ -0,0 +1,287 @@
+/*
+ * File:    CompressedFormatTarget.cpp
+ * Author:  Conor Finegan
+ * Contact: conor_finegan@student.uml.edu
+ *
+ * Created on October 17, 2026
+ */
+
+#include "CompressedFormatTarget.h"
+
+#include <algorithm>
+#include <climits>
+#include <stdexcept>
+#include <vector>
+
+#include <zlib.h>
+
+#ifdef WITH_ZSTD
+#include <zstd.h>
+#endif
+
+using namespace std;
+XERCES_CPP_NAMESPACE_USE
+
+namespace
+{
+    /**
+     * Size of the buffer compressed output is gathered in before being
+     *      passed to the sink.
+     */
+    constexpr size_t output_buffer_size = 256 * 1024;
+    
+    /**
+     * Adds gzip's header and trailer to zlib's output.
+     */
+    constexpr int gzip_window_bits = 15 + 16;
+}
+
+struct CompressedFormatTarget::Compressor
+{
+    Compressor(XMLFormatTarget& sink, const Algorithm algorithm)
+            : sink(sink), algorithm(algorithm), output(output_buffer_size)
+    {
+    }
+    
+    /**
+     * Passes the compressed bytes in \c output on to the sink.
+     * @param size Number of bytes of \c output to pass on.
+     */
+    void Drain(const size_t size)
+    {
+        if (size == 0) { return; }
+        
+        sink.writeChars(reinterpret_cast<const XMLByte*>(output.data()), size,
+                nullptr);
+        bytes_out += size;
+    }
+    
+    /**
+     * Compresses input, or ends the stream.
+     * @param data   Bytes to compress.
+     * @param size   Number of bytes to compress.
+     * @param finish \c true to end the stream after these bytes.
+     */
+    void Compress(const char* data, const size_t size, const bool finish)
+    {
+        if (failed) { return; }
+        
+        if (algorithm == Algorithm::Gzip)
+        {
+            // zlib counts in unsigned ints, so feed it no more than that
+            //      at once
+            const char* pos = data;
+            size_t remaining = size;
+            
+            do
+            {
+                const uInt chunk = static_cast<uInt>(
+                        min<size_t>(remaining, UINT_MAX));
+                const bool last = (chunk == remaining);
+                
+                zlib.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(pos));
+                zlib.avail_in = chunk;
+                
+                int result;
+                
+                // Keep going until zlib has taken all of the input (and,
+                //      when finishing, written all of its output)
+                do
+                {
+                    zlib.next_out = reinterpret_cast<Bytef*>(output.data());
+                    zlib.avail_out = static_cast<uInt>(output.size());
+                    
+                    result = deflate(&zlib, 
+                            (finish && last) ? Z_FINISH : Z_NO_FLUSH);
+                    
+                    if (result == Z_STREAM_ERROR)
+                    {
+                        failed = true;
+                        return;
+                    }
+                    
+                    Drain(output.size() - zlib.avail_out);
+                }
+                while (zlib.avail_out == 0 || 
+                        (finish && last && result != Z_STREAM_END));
+                
+                pos += chunk;
+                remaining -= chunk;
+            }
+            while (remaining > 0);
+        }
+        
+#ifdef WITH_ZSTD
+        else
+        {
+            ZSTD_inBuffer in = { data, size, 0 };
+            size_t pending;
+            
+            // Keep going until zstd has taken all of the input (and, when
+            //      finishing, written all of its output)
+            do
+            {
+                ZSTD_outBuffer out = { output.data(), output.size(), 0 };
+                
+                pending = ZSTD_compressStream2(zstd, &out, &in, 
+                        finish ? ZSTD_e_end : ZSTD_e_continue);
+                
+                if (ZSTD_isError(pending))
+                {
+                    failed = true;
+                    return;
+                }
+                
+                Drain(out.pos);
+            }
+            while (in.pos < in.size || (finish && pending != 0));
+        }
+#endif
+    }
+    
+    /** Target that receives the compressed bytes. */
+    XMLFormatTarget& sink;
+    
+    /** Compression format. */
+    const Algorithm algorithm;
+    
+    /** Compressed output waiting to be passed to the sink. */
+    vector<char> output;
+    
+    /** zlib's state, when compressing to gzip. */
+    z_stream zlib = z_stream();
+    
+#ifdef WITH_ZSTD
+    /** zstd's state, when compressing to zstd. */
+    ZSTD_CCtx* zstd = nullptr;
+#endif
+    
+    /** \c true once compression has failed. */
+    bool failed = false;
+    
+    /** \c true once the stream has been ended. */
+    bool finished = false;
+    
+    /** Number of uncompressed bytes received. */
+    uint64_t bytes_in = 0;
+    
+    /** Number of compressed bytes passed to the sink. */
+    uint64_t bytes_out = 0;
+};
+
+bool CompressedFormatTarget::IsAvailable(const Algorithm algorithm)
+{
+#ifdef WITH_ZSTD
+    return true;
+#else
+    return algorithm == Algorithm::Gzip;
+#endif
+}
+
+bool CompressedFormatTarget::FromFileName(const std::string& filename,
+        Algorithm& algorithm)
+{
+    // Does the file name end with the given extension?
+    auto has_extension = [&filename](const string& extension)
+    {
+        return filename.size() > extension.size() && filename.compare(
+                filename.size() - extension.size(), extension.size(), 
+                extension) == 0;
+    };
+    
+    if (has_extension(".gz"))
+    {
+        algorithm = Algorithm::Gzip;
+        return true;
+    }
+    
+    if (has_extension(".zst"))
+    {
+        algorithm = Algorithm::Zstd;
+        return true;
+    }
+    
+    return false;
+}
+
+CompressedFormatTarget::CompressedFormatTarget(XMLFormatTarget& sink, 
+        const Algorithm algorithm) 
+        : compressor(new Compressor(sink, algorithm))
+{
+    if (!IsAvailable(algorithm))
+    {
+        throw std::runtime_error("zstd compression is not available in this "
+                "build.");
+    }
+    
+    if (algorithm == Algorithm::Gzip)
+    {
+        if (deflateInit2(&compressor->zlib, Z_DEFAULT_COMPRESSION, Z_DEFLATED,
+                gzip_window_bits, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+        {
+            throw std::runtime_error("The gzip compressor could not be "
+                    "initialized.");
+        }
+    }
+    
+#ifdef WITH_ZSTD
+    else
+    {
+        compressor->zstd = ZSTD_createCCtx();
+        
+        if (!compressor->zstd)
+        {
+            throw std::runtime_error("The zstd compressor could not be "
+                    "initialized.");
+        }
+    }
+#endif
+}
+
+CompressedFormatTarget::~CompressedFormatTarget() noexcept
+{
+    if (compressor->algorithm == Algorithm::Gzip)
+    {
+        deflateEnd(&compressor->zlib);
+    }
+    
+#ifdef WITH_ZSTD
+    else
+    {
+        ZSTD_freeCCtx(compressor->zstd);
+    }
+#endif
+}
+
+void CompressedFormatTarget::writeChars(const XMLByte* const toWrite,
+        const XMLSize_t count, XMLFormatter* const formatter)
+{
+    compressor->bytes_in += count;
+    compressor->Compress(reinterpret_cast<const char*>(toWrite), count, false);
+}
+
+void CompressedFormatTarget::flush()
+{
+}
+
+bool CompressedFormatTarget::Finish()
+{
+    if (!compressor->finished)
+    {
+        compressor->Compress(nullptr, 0, true);
+        compressor->sink.flush();
+        compressor->finished = true;
+    }
+    
+    return !compressor->failed;
+}
+
+std::uint64_t CompressedFormatTarget::BytesIn() const
+{
+    return compressor->bytes_in;
+}
+
+std::uint64_t CompressedFormatTarget::BytesOut() const
+{
+    return compressor->bytes_out;
+}
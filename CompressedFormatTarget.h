@@ -0,0 +1,138 @@
+/*
+ * File:    CompressedFormatTarget.h
+ * Author:  Conor Finegan
+ * Contact: conor_finegan@student.uml.edu
+ *
+ * Created on October 17, 2026
+ */
+
+#ifndef COMPRESSEDFORMATTARGET_H
+#define	COMPRESSEDFORMATTARGET_H
+
+#include <xercesc/framework/XMLFormatter.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+/**
+ * The \c CompressedFormatTarget class is a Xerces-C format target that
+ *      compresses the serializer's output as it arrives and passes the
+ *      compressed bytes on to another format target, so that the
+ *      uncompressed document is never held in memory. gzip (through zlib)
+ *      is always available; zstd is available when the program is built
+ *      with \c WITH_ZSTD defined and linked against libzstd, as the
+ *      Makefile does when it finds libzstd. Compression
+ *      errors don't throw from inside the serializer; they are recorded and
+ *      reported by Finish().
+ * @author Conor Finegan<br>conor_finegan@student.uml.edu
+ * @version 1.0
+ */
+class CompressedFormatTarget final : public XERCES_CPP_NAMESPACE::XMLFormatTarget
+{
+public:
+    
+    /**
+     * Supported compression formats.
+     */
+    enum class Algorithm
+    {
+        Gzip,
+        Zstd
+    };
+    
+    /**
+     * @param algorithm A compression format.
+     * @return \c true if this build supports \c algorithm.
+     */
+    static bool IsAvailable(const Algorithm algorithm);
+    
+    /**
+     * Chooses a compression format from a file name's extension.
+     * @param filename  Name of the file being written.
+     * @param algorithm Receives the format for ".gz" or ".zst" files.
+     * @return \c true if the extension names a compression format.
+     */
+    static bool FromFileName(const std::string& filename, 
+            Algorithm& algorithm);
+    
+    /**
+     * Starts a compressed stream.
+     * @param sink      Target that receives the compressed bytes. Must
+     *      outlive this object.
+     * @param algorithm Compression format.
+     * @throw std::runtime_error If \c algorithm is not available, or the
+     *      compressor can't be initialized.
+     */
+    CompressedFormatTarget(XERCES_CPP_NAMESPACE::XMLFormatTarget& sink,
+            const Algorithm algorithm);
+    
+    /**
+     * Disabled copy constructor \n
+     * Copying is disabled because each target owns its compressor.
+     */
+    CompressedFormatTarget(const CompressedFormatTarget&) = delete;
+    
+    /**
+     * Disabled copy-assignment operator \n
+     * Copying is disabled because each target owns its compressor.
+     */
+    void operator=(const CompressedFormatTarget&) = delete;
+    
+    /**
+     * Destructor \n
+     * Releases the compressor. Finish() must be called first for the output
+     *      to be complete.
+     */
+    ~CompressedFormatTarget() noexcept;
+    
+    /**
+     * Compresses output from the serializer, passing compressed bytes on to
+     *      the sink whenever the output buffer fills.
+     * @param toWrite   Bytes to compress.
+     * @param count     Number of bytes to compress.
+     * @param formatter Unused.
+     */
+    void writeChars(const XMLByte* const toWrite, const XMLSize_t count,
+            XERCES_CPP_NAMESPACE::XMLFormatter* const formatter) override;
+    
+    /**
+     * Does nothing. Flushing a compressed stream part-way through costs
+     *      compression, and the stream can't be read until it is finished
+     *      anyway.
+     */
+    void flush() override;
+    
+    /**
+     * Ends the compressed stream, passing the last of it to the sink, and
+     *      flushes the sink. Further calls do nothing.
+     * @return \c false if compression failed at any point.
+     */
+    bool Finish();
+    
+    /**
+     * @return The number of uncompressed bytes received so far.
+     */
+    std::uint64_t BytesIn() const;
+    
+    /**
+     * @return The number of compressed bytes passed to the sink so far.
+     */
+    std::uint64_t BytesOut() const;
+    
+private:
+    
+    /**
+     * State of the compressor, which depends on the format and on the
+     *      libraries available; see CompressedFormatTarget.cpp.
+     */
+    struct Compressor;
+    
+    /**
+     * The compressor in use.
+     */
+    std::unique_ptr<Compressor> compressor;
+};
+
+#endif	/* COMPRESSEDFORMATTARGET_H */
+
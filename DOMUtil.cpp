@@ -8,12 +8,107 @@
 
 #include "DOMUtil.h"
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <system_error>
+#include <thread>
+
+#include <xercesc/util/XMLUniDefs.hpp>
+
 using namespace std;
 XERCES_CPP_NAMESPACE_USE
 
+namespace
+{
+    /**
+     * Number of subtrees per thread that FindElementsByTagName() aims for
+     *      when it splits the tree. More subtrees even out the threads' work;
+     *      fewer cost less to hand out.
+     */
+    const size_t SUBTREES_PER_THREAD = 8;
+    
+    /**
+     * Deepest level that FindElementsByTagName() splits the tree at.
+     */
+    const size_t MAX_SPLIT_DEPTH = 4;
+    
+    /**
+     * AppendDocSubTree() writes its buffer out whenever this much has been
+     *      formatted; the same as \c DocumentStreamer.
+     */
+    const size_t FLUSH_THRESHOLD = 64 * 1024;
+    
+    /**
+     * A part of the tree searched by FindElementsByTagName(): a node, and
+     *      everything beneath it if \c subtree is set.
+     */
+    struct SearchTask
+    {
+        DOMNode* node;
+        bool subtree;
+    };
+    
+    /**
+     * Appends the elements with a given name to a list, in document order.
+     * @param task    Part of the tree to search.
+     * @param name    Tag name of the elements to find.
+     * @param any     \c true to match every element, whatever \c name is.
+     * @param matches Receives the matching elements.
+     */
+    void SearchTree(const SearchTask& task, const XMLCh* name, const bool any,
+            vector<DOMNode*>& matches)
+    {
+        // Visit the subtree in document order, without recursion
+        DOMNode* next = task.node;
+        
+        while (next)
+        {
+            if (next->getNodeType() == DOMNode::ELEMENT_NODE &&
+                    (any || XMLString::equals(next->getNodeName(), name)))
+            {
+                matches.push_back(next);
+            }
+            
+            if (!task.subtree)
+            {
+                break;
+            }
+            
+            if (next->getFirstChild())
+            {
+                next = next->getFirstChild();
+                continue;
+            }
+            
+            while (next != task.node && !next->getNextSibling())
+            {
+                next = next->getParentNode();
+            }
+            
+            next = (next == task.node) ? nullptr : next->getNextSibling();
+        }
+    }
+}
+
 DOMNode* DOMUtil::SelectNodeFromList(DOMNodeList* param_nodes)
 {
-    const XMLSize_t param_nodes_size = param_nodes->getLength();
+    // Copy the live list so both overloads share one implementation
+    const XMLSize_t param_nodes_len = param_nodes->getLength();
+    vector<DOMNode*> nodes(param_nodes_len);
+    
+    for (XMLSize_t i = 0; i < param_nodes_len; ++ i)
+    {
+        nodes[i] = param_nodes->item(i);
+    }
+    
+    return SelectNodeFromList(nodes);
+}
+
+DOMNode* DOMUtil::SelectNodeFromList(const std::vector<DOMNode*>& param_nodes)
+{
+    const XMLSize_t param_nodes_size = param_nodes.size();
     
     // Return null if input container is empty
     if (!param_nodes_size)
@@ -24,7 +119,7 @@ DOMNode* DOMUtil::SelectNodeFromList(DOMNodeList* param_nodes)
     // If there is only 1 result, it will be used by default
     else if (param_nodes_size == 1)
     {
-        return param_nodes->item(0);
+        return param_nodes[0];
     }
     
     // Else prompt user to select node
@@ -35,7 +130,7 @@ DOMNode* DOMUtil::SelectNodeFromList(DOMNodeList* param_nodes)
     for (XMLSize_t i = 0; i < param_nodes_size; ++ i)
     {
         cout << i+1 << ") ";
-        OutputNodeDescription(param_nodes->item(i));        
+        OutputNodeDescription(param_nodes[i]);        
     }
 
     // Get index of target node from user
@@ -44,7 +139,207 @@ DOMNode* DOMUtil::SelectNodeFromList(DOMNodeList* param_nodes)
     // Sanity check: final index must be within range
     assert(user_selection < param_nodes_size);
     
-    return param_nodes->item(user_selection);
+    return param_nodes[user_selection];
+}
+
+std::vector<DOMNode*> DOMUtil::SelectNodesFromList(
+        const std::vector<DOMNode*>& param_nodes, const SelectionPolicy policy)
+{
+    // Nothing to choose between
+    if (param_nodes.size() <= 1)
+    {
+        return param_nodes;
+    }
+    
+    switch (policy)
+    {
+        case SelectionPolicy::Prompt:
+            return vector<DOMNode*>(1, SelectNodeFromList(param_nodes));
+            
+        case SelectionPolicy::First:
+            return vector<DOMNode*>(1, param_nodes.front());
+            
+        case SelectionPolicy::Last:
+            return vector<DOMNode*>(1, param_nodes.back());
+            
+        case SelectionPolicy::All:
+            return param_nodes;
+            
+        case SelectionPolicy::Error:
+            break;
+    }
+    
+    return vector<DOMNode*>();
+}
+
+bool DOMUtil::ParseSelectionPolicy(const std::string& name, 
+        SelectionPolicy& policy)
+{
+    static const struct
+    {
+        const char* name;
+        SelectionPolicy policy;
+    }
+    policies[] =
+    {
+        { "prompt", SelectionPolicy::Prompt },
+        { "first",  SelectionPolicy::First  },
+        { "last",   SelectionPolicy::Last   },
+        { "all",    SelectionPolicy::All    },
+        { "error",  SelectionPolicy::Error  }
+    };
+    
+    for (const auto& entry : policies)
+    {
+        if (jmhUtilities::caseInsCompare(name, entry.name))
+        {
+            policy = entry.policy;
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+std::vector<DOMNode*> DOMUtil::FindElementsByTagName(DOMNode* root,
+        const XMLCh* name, const std::size_t threads)
+{
+    static const XMLCh any_name[] = { chAsterisk, chNull };
+    const bool any = XMLString::equals(name, any_name);
+    
+    // Split the top levels of the tree until there are enough subtrees. A
+    //      split node is searched on its own, just before its children, so
+    //      the tasks stay in document order.
+    vector<SearchTask> tasks;
+    
+    for (DOMNode* child = root->getFirstChild(); child;
+            child = child->getNextSibling())
+    {
+        tasks.push_back(SearchTask{ child, true });
+    }
+    
+    const size_t wanted = max<size_t>(threads, 1) * SUBTREES_PER_THREAD;
+    
+    for (size_t depth = 0; depth < MAX_SPLIT_DEPTH && threads > 1 &&
+            tasks.size() < wanted; ++ depth)
+    {
+        vector<SearchTask> split;
+        split.reserve(tasks.size());
+        
+        for (const SearchTask& task : tasks)
+        {
+            if (!task.subtree || !task.node->getFirstChild())
+            {
+                split.push_back(task);
+                continue;
+            }
+            
+            split.push_back(SearchTask{ task.node, false });
+            
+            for (DOMNode* child = task.node->getFirstChild(); child;
+                    child = child->getNextSibling())
+            {
+                split.push_back(SearchTask{ child, true });
+            }
+        }
+        
+        // Nothing left to split
+        if (split.size() == tasks.size())
+        {
+            break;
+        }
+        
+        tasks.swap(split);
+    }
+    
+    // Consecutive tasks are grouped into batches, and each thread takes the
+    //      next batch as soon as it finishes one. Every list of matches is
+    //      written by exactly one thread.
+    const size_t batch_size = max<size_t>(tasks.size() / wanted, 1);
+    vector<vector<DOMNode*>> batches((tasks.size() + batch_size - 1) /
+            batch_size);
+    
+    atomic<size_t> next(0);
+    mutex error_mutex;
+    exception_ptr error;
+    
+    // The threads share the document without a lock. Xerces-C leaves the use
+    //      of one document by several threads to the application, so they
+    //      keep to getNodeType(), getNodeName(), getFirstChild(),
+    //      getNextSibling() and getParentNode(). In Xerces-C 3 these only
+    //      read fields of the node (DOMNodeImpl, DOMParentNode, DOMChildNode
+    //      and DOMElementImpl): nothing is built on demand or allocated from
+    //      the document, as getElementsByTagName() does with the node lists
+    //      it caches in the document. The caller keeps the tree unchanged
+    //      until the search is over.
+    const auto work = [&]()
+    {
+        try
+        {
+            for (size_t i = next++; i < batches.size(); i = next++)
+            {
+                const size_t end = min((i + 1) * batch_size, tasks.size());
+                
+                for (size_t j = i * batch_size; j < end; ++ j)
+                {
+                    SearchTree(tasks[j], name, any, batches[i]);
+                }
+            }
+        }
+        
+        // The first error is passed on, and the other threads stop early
+        catch (...)
+        {
+            lock_guard<mutex> lock(error_mutex);
+            if (!error) { error = current_exception(); }
+            next = batches.size();
+        }
+    };
+    
+    // The calling thread is one of the workers
+    const size_t workers = min(max<size_t>(threads, 1), batches.size());
+    vector<thread> pool;
+    
+    try
+    {
+        for (size_t i = 1; i < workers; ++ i)
+        {
+            pool.emplace_back(work);
+        }
+    }
+    
+    // With fewer threads than asked for, the whole tree is still searched
+    catch (const std::system_error&)
+    {
+    }
+    
+    work();
+    
+    for (thread& worker : pool)
+    {
+        worker.join();
+    }
+    
+    if (error)
+    {
+        rethrow_exception(error);
+    }
+    
+    size_t total = 0;
+    for (const vector<DOMNode*>& batch : batches)
+    {
+        total += batch.size();
+    }
+    
+    vector<DOMNode*> matches;
+    matches.reserve(total);
+    
+    for (const vector<DOMNode*>& batch : batches)
+    {
+        matches.insert(matches.end(), batch.begin(), batch.end());
+    }
+    
+    return matches;
 }
 
 void DOMUtil::OutputNodeDescription(DOMNode* node)
@@ -75,37 +370,105 @@ void DOMUtil::OutputNodeDescription(DOMNode* node)
 }
 
 void DOMUtil::OutputDocSubTree( const size_t depth, DOMNode* root)
+{
+    string buffer;
+    AppendDocSubTree(buffer, depth, root, &cout);
+    
+    // The last of the sub-tree, and a single flush
+    cout.write(buffer.data(), buffer.size());
+    cout.flush();
+}
+
+void DOMUtil::AppendDocSubTree(std::string& buffer, const size_t depth,
+        DOMNode* root, std::ostream* out)
+{
+    AppendNode(buffer, depth, root);
+    
+    // Walk the rest of the sub-tree in document order. Rather than recursing,
+    //      the walk climbs back up through getParentNode(), so its memory use
+    //      doesn't grow with the depth of the tree.
+    DOMNode* node = root;
+    size_t node_depth = depth;
+    
+    for (;;) // For ever...
+    {
+        // Descend to the first child if there is one...
+        DOMNode* next = SkipTextNodes(node->getFirstChild());
+        
+        if (next)
+        {
+            ++ node_depth;
+        }
+        
+        // ...otherwise move on to the next sibling of the closest ancestor
+        //      that has one, without ever leaving the sub-tree under root
+        else
+        {
+            while (node != root)
+            {
+                next = SkipTextNodes(node->getNextSibling());
+                if (next) { break; }
+                
+                node = node->getParentNode();
+                -- node_depth;
+            }
+            
+            // Back at the root: every node has been visited
+            if (!next) { break; }
+        }
+        
+        node = next;
+        AppendNode(buffer, node_depth, node);
+        
+        // clear() keeps the capacity, so the buffer stops growing here
+        if (out && buffer.size() >= FLUSH_THRESHOLD)
+        {
+            out->write(buffer.data(), buffer.size());
+            buffer.clear();
+        }
+    }
+}
+
+void DOMUtil::AppendNode(std::string& buffer, const size_t depth, 
+        DOMNode* node)
 {
     // Amount of spaces in a tab. Could make configurable later.
     constexpr size_t tab_size = 4;
+    
+    // Indentation of this node, and of its attributes and value
+    const size_t indent = depth * tab_size;
+    const size_t inner_indent = indent + tab_size;
            
     // Print node name
-    for(size_t i = 0; i < depth * tab_size; ++ i) { cout << " "; }
-    cout << "[Node] " << LSTR(root->getNodeName());
+    buffer.append(indent, ' ');
+    buffer += "[Node] ";
+    AppendLocalForm(buffer, node->getNodeName());
     
     // Get node text
-    DOMNode* tnode = root->getFirstChild();
+    DOMNode* tnode = node->getFirstChild();
     if (tnode && tnode->getNodeType() == DOMNode::TEXT_NODE)
     {
-        LocalStr node_text(tnode->getNodeValue());
+        const XMLCh* node_text = tnode->getNodeValue();
         if (node_text) 
         { 
-            cout << ": " << node_text; 
+            buffer += ": ";
+            AppendLocalForm(buffer, node_text);
         } 
     }
     
-    cout << endl;
+    buffer += '\n';
     
     // Print node value if it exists
-    LocalStr node_val(root->getNodeValue());
+    const XMLCh* node_val = node->getNodeValue();
     if (node_val)
     {
-        for (size_t i = 0; i < depth * tab_size + tab_size; ++ i) { cout << " " ; }
-        cout << "[Value] " << node_val;
+        buffer.append(inner_indent, ' ');
+        buffer += "[Value] ";
+        AppendLocalForm(buffer, node_val);
     }
     
     // Print attributes
-    DOMNamedNodeMap* attr = root->getAttributes();
+    DOMNamedNodeMap* attr = node->getAttributes();
     if (attr != nullptr)
     {
         // Enumerate attributes
@@ -116,35 +479,54 @@ void DOMUtil::OutputDocSubTree( const size_t depth, DOMNode* root)
             DOMNode* attr_node = attr->item(i);          
             
             // Print white-space buffer of parent + 1
-            for (size_t i = 0; i < depth * tab_size + tab_size; ++ i) { cout << " "; }
+            buffer.append(inner_indent, ' ');
             
             // Output attribute information
-            cout << "[Attribute] " << LSTR(attr_node->getNodeName()) << ": " 
-                    << LSTR(attr_node->getNodeValue()) << endl;
+            buffer += "[Attribute] ";
+            AppendLocalForm(buffer, attr_node->getNodeName());
+            buffer += ": ";
+            AppendLocalForm(buffer, attr_node->getNodeValue());
+            buffer += '\n';
         }
     }
-        
-    // Recursively call helper for each child
-    DOMNodeList* children = root->getChildNodes();
-    if (children != nullptr)
+}
+
+DOMNode* DOMUtil::SkipTextNodes(DOMNode* node)
+{
+    while (node && node->getNodeType() == DOMNode::TEXT_NODE)
+    {
+        node = node->getNextSibling();
+    }
+    
+    return node;
+}
+
+void DOMUtil::AppendLocalForm(std::string& buffer, const XMLCh* xml_str)
+{
+    // Fast path: ASCII is the same in the local code page, so it can be
+    //      narrowed one character at a time
+    const XMLCh* pos = xml_str;
+    while (*pos != 0 && *pos < 0x80)
+    {
+        ++ pos;
+    }
+    
+    if (*pos == 0)
     {
-        // Enumerate children
-        XMLSize_t children_len = children->getLength();
-        for (XMLSize_t i = 0; i < children_len; ++i)
+        for (pos = xml_str; *pos != 0; ++ pos)
         {
-            // Load child
-            DOMNode* child = children->item(i);
-            
-            // Only recursively call for non-text nodes
-            if (child->getNodeType() != DOMNode::TEXT_NODE)
-            {
-                OutputDocSubTree(depth + 1, child);
-            }
+            buffer += static_cast<char>(*pos);
         }
     }
+    
+    // Anything else goes through the transcoder
+    else
+    {
+        buffer += LSTR(xml_str);
+    }
 }
 
-bool DOMUtil::RemoveNodeFromParent(DOMNode* target)
+bool DOMUtil::RemoveNodeFromParent(DOMNode* target, NodeIndex* index)
 {
     // Cache target name for later output
     LocalStr target_name(target->getNodeName());
@@ -161,6 +543,25 @@ bool DOMUtil::RemoveNodeFromParent(DOMNode* target)
 
     if (removed) // If node is no longer in document
     {
+        // Unregister the subtree while its nodes are still valid
+        if (index) { index->Remove(removed); }
+        
+        // Release the descendants deepest first, so that no node has
+        //      children left when it is released. release() frees the
+        //      children it finds recursively, which a deep subtree could
+        //      overflow the stack with.
+        DOMNode* node = removed;
+        
+        for (;;)
+        {
+            while (node->getLastChild()) { node = node->getLastChild(); }
+            if (node == removed) { break; }
+            
+            DOMNode* const node_parent = node->getParentNode();
+            node_parent->removeChild(node)->release();
+            node = node_parent;
+        }
+        
         // Release the node from memory
         removed->release();
 
@@ -172,6 +573,47 @@ bool DOMUtil::RemoveNodeFromParent(DOMNode* target)
     return false;
 }
 
+DOMDocument* DOMUtil::CloneDocument(DOMImplementation* impl, 
+        const DOMDocument* source)
+{
+    DOMDocument* copy = impl->createDocument();
+    
+    try
+    {
+        copy->setXmlVersion(source->getXmlVersion());
+        copy->setXmlStandalone(source->getXmlStandalone());
+        
+        for (DOMNode* child = source->getFirstChild(); child; 
+                child = child->getNextSibling())
+        {
+            // A document type can't be imported, but an equivalent one can
+            //      be created
+            if (child->getNodeType() == DOMNode::DOCUMENT_TYPE_NODE)
+            {
+                const DOMDocumentType* type = 
+                        static_cast<const DOMDocumentType*>(child);
+                
+                copy->appendChild(impl->createDocumentType(type->getName(), 
+                        type->getPublicId(), type->getSystemId()));
+            }
+            
+            else
+            {
+                copy->appendChild(copy->importNode(child, true));
+            }
+        }
+    }
+    
+    // Don't leak a partial copy
+    catch (...)
+    {
+        copy->release();
+        throw;
+    }
+    
+    return copy;
+}
+
 XMLSize_t DOMUtil::GetPositiveIndex(const XMLSize_t range_max)
 {
     // Sanity check: a range_max of zero would trap the user in an
@@ -12,6 +12,7 @@
 #include "XStr.h"
 #include "LocalStr.h"
 #include "CmdUtil.h"
+#include "NodeIndex.h"
 
 #include <xercesc/util/PlatformUtils.hpp>
 #include <xercesc/util/OutOfMemoryException.hpp>
@@ -23,7 +24,9 @@
 #include <xercesc/util/XMLString.hpp>
 
 #include <cassert>
+#include <cstddef>
 #include <iostream>
+#include <string>
 #include <vector>
 
 
@@ -38,6 +41,51 @@ class DOMUtil
 {
 public:
     
+    /**
+     * Ways of choosing among several nodes that match the same name.
+     */
+    enum class SelectionPolicy
+    {
+        /** Ask the user with SelectNodeFromList(). */
+        Prompt,
+        
+        /** Use the first match in document order. */
+        First,
+        
+        /** Use the last match in document order. */
+        Last,
+        
+        /** Use every match. */
+        All,
+        
+        /** Use none of them; the caller reports an error. */
+        Error
+    };
+    
+    /**
+     * Narrows a list of matching nodes down according to a selection policy.
+     *      If the list holds one node, it is always selected, whatever the
+     *      policy. Only the \c Prompt policy reads from standard input.
+     * @param param_nodes Input nodes, in document order.
+     * @param policy      How to choose among several nodes.
+     * @return The selected nodes in document order. The result is empty if
+     *      the input is empty, or if it holds several nodes and the policy is
+     *      \c Error.
+     */
+    static std::vector<XERCES_CPP_NAMESPACE::DOMNode*> SelectNodesFromList(
+            const std::vector<XERCES_CPP_NAMESPACE::DOMNode*>& param_nodes,
+            const SelectionPolicy policy);
+    
+    /**
+     * Converts the name of a selection policy ("prompt", "first", "last",
+     *      "all" or "error", not case-sensitive) to its value.
+     * @param name   Name of the policy.
+     * @param policy Receives the policy if \c name is valid.
+     * @return \c true if \c name names a policy.
+     */
+    static bool ParseSelectionPolicy(const std::string& name,
+            SelectionPolicy& policy);
+    
     /**
      * Prompts the user to select a specific \c DOMNode out of the given
      *      container. First checks the size of the container, returning null
@@ -56,6 +104,37 @@ public:
     static XERCES_CPP_NAMESPACE::DOMNode* SelectNodeFromList(
             XERCES_CPP_NAMESPACE::DOMNodeList* param_nodes);
     
+    /**
+     * Overload of SelectNodeFromList() for a list of nodes gathered by the
+     *      caller, e.g. from a \c NodeIndex. Behaves identically to the
+     *      \c DOMNodeList version.
+     * @param param_nodes Input nodes, in document order.
+     * @return The Node selected by the user, or \c nullptr if the input
+     *      container was empty.
+     */
+    static XERCES_CPP_NAMESPACE::DOMNode* SelectNodeFromList(
+            const std::vector<XERCES_CPP_NAMESPACE::DOMNode*>& param_nodes);
+    
+    /**
+     * Finds every element beneath a node with a given name, like
+     *      \c getElementsByTagName, but searching on several threads. The top
+     *      levels of the tree are split into subtrees, which the threads take
+     *      in small batches as soon as they finish one, and the matches of
+     *      each batch are put back together in document order. The tree must
+     *      not change while it is searched; the threads only read it, through
+     *      accessors that are safe to call concurrently (see DOMUtil.cpp).
+     * @param root    Node to search beneath; it is not matched itself.
+     * @param name    Tag name of the elements to find, or "*" for every
+     *      element.
+     * @param threads Highest number of threads to search on, including the
+     *      calling thread.
+     * @return The matching elements, in document order, exactly as
+     *      \c getElementsByTagName would list them.
+     */
+    static std::vector<XERCES_CPP_NAMESPACE::DOMNode*> FindElementsByTagName(
+            XERCES_CPP_NAMESPACE::DOMNode* root, const XMLCh* name,
+            const std::size_t threads);
+    
     
     /**
      * Outputs a description of the specified node, listing its name, parent
@@ -69,18 +148,46 @@ public:
     static void OutputNodeDescription(XERCES_CPP_NAMESPACE::DOMNode* node);
     
     /**
-     * Recursive function to output an element and all of its children. This
-     *      method first prints a node's name, then it's content if applicable.
-     *      The node's attributes are then printed, followed by a recursive call
-     *      to this method for each of node's children.
+     * Outputs an element and all of its children to standard out. The text
+     *      is formatted by AppendDocSubTree(), written in blocks of about
+     *      64 KB, and flushed once at the end.
      * @param depth Curent depth in the tree structure. Mainly used for
      *      formatting purposes.
-     * @param root  Pointer to the current node being output. This method will
-     *      also be called recursively for each of <code>node</code>'s children.
+     * @param root  Pointer to the root of the sub-tree being output.
      */
     static void OutputDocSubTree( const size_t depth,
             XERCES_CPP_NAMESPACE::DOMNode* root);
     
+    /**
+     * Formats an element and all of its children. Each node is formatted by
+     *      AppendNode(), and its non-text children follow it in document
+     *      order, indented one level deeper. The tree is walked iteratively
+     *      with \c getFirstChild() and \c getNextSibling(), so documents of
+     *      any depth can be printed without exhausting the stack. Given a
+     *      stream, the buffer is written to it and emptied whenever it holds
+     *      more than about 64 KB, so that the memory used doesn't grow with
+     *      the size of the output; the last of it is left for the caller to
+     *      write. Without one, the caller can gather the output of many
+     *      sub-trees and write it all at once.
+     * @param buffer Output buffer the text is appended to.
+     * @param depth  Depth of \c root in the tree structure. Mainly used for
+     *      formatting purposes.
+     * @param root   Pointer to the root of the sub-tree being output.
+     * @param out    Stream the buffer is written to as it fills up, or
+     *      \c nullptr to keep everything in the buffer.
+     */
+    static void AppendDocSubTree(std::string& buffer, const size_t depth,
+            XERCES_CPP_NAMESPACE::DOMNode* root, std::ostream* out = nullptr);
+    
+    /**
+     * Appends the system-local form of an XML string to a buffer. Strings that
+     *      are pure ASCII (nearly all element and attribute names) are copied
+     *      directly, without calling the transcoder or allocating.
+     * @param buffer Output buffer the text is appended to.
+     * @param xml_str String to append. Must not be null.
+     */
+    static void AppendLocalForm(std::string& buffer, const XMLCh* xml_str);
+    
     /**
      * This method will, given a pointer to a \c DOMNode, attempt to remove the
      *      target from its parent. If the node is successfully removed, it will
@@ -89,9 +196,29 @@ public:
      *      the node not having a parent, or the \c removeChild() method
      *      failing).
      * @param target Node to be removed
+     * @param index  Optional index of the document. If given, \c target and
+     *      every element beneath it are unregistered from the index before
+     *      they are freed. The subtree is freed iteratively, from its deepest
+     *      nodes up, so that subtrees of any depth can be removed.
      * @return \c true if the node was successfully removed, \c false if it was not.
      */
-    static bool RemoveNodeFromParent(XERCES_CPP_NAMESPACE::DOMNode* target);
+    static bool RemoveNodeFromParent(XERCES_CPP_NAMESPACE::DOMNode* target,
+            NodeIndex* index = nullptr);
+    
+    /**
+     * Makes a deep copy of a document, so that the copy can be used (for
+     *      instance, serialized on another thread) while the original goes on
+     *      changing. The copy is allocated by the global memory manager. The
+     *      XML version, standalone flag and document type are carried over,
+     *      but not the internal subset of the document type.
+     * @param impl   Implementation that creates the copy.
+     * @param source Document to copy.
+     * @return The copy. The caller owns it and must \c release() it.
+     * @throw DOMException If a node can't be imported.
+     */
+    static XERCES_CPP_NAMESPACE::DOMDocument* CloneDocument(
+            XERCES_CPP_NAMESPACE::DOMImplementation* impl,
+            const XERCES_CPP_NAMESPACE::DOMDocument* source);
         
 private:
     
@@ -112,6 +239,26 @@ private:
      * @return The value input by the user, minus 1.
      */
     static XMLSize_t GetPositiveIndex(const XMLSize_t range_max);
+    
+    /**
+     * Formats a single node for AppendDocSubTree(): the node's name, then its
+     *      content if applicable, then its attributes.
+     * @param buffer Output buffer the text is appended to.
+     * @param depth  Depth of \c node in the tree structure.
+     * @param node   The node being output.
+     */
+    static void AppendNode(std::string& buffer, const size_t depth,
+            XERCES_CPP_NAMESPACE::DOMNode* node);
+    
+    /**
+     * Skips over text nodes, which AppendDocSubTree() does not print as
+     *      nodes of their own.
+     * @param node First candidate node. May be null.
+     * @return \c node or its first following sibling that is not a text
+     *      node, or \c nullptr if there is none.
+     */
+    static XERCES_CPP_NAMESPACE::DOMNode* SkipTextNodes(
+            XERCES_CPP_NAMESPACE::DOMNode* node);
 };
 
 #endif	/* DOMUTIL_H */
@@ -0,0 +1,121 @@
+/*
+ * File:    DocumentLoader.cpp
+ * Author:  Conor Finegan
+ * Contact: conor_finegan@student.uml.edu
+ *
+ * Created on October 17, 2026
+ */
+
+#include "DocumentLoader.h"
+
+#include <chrono>
+#include <sstream>
+
+using namespace std;
+XERCES_CPP_NAMESPACE_USE
+
+namespace
+{
+    /**
+     * \c HandlerBase only throws on fatal errors, so validation errors would
+     *      pass silently. This handler throws on both, so that the first
+     *      problem found is reported along with its location.
+     */
+    class LoadErrorHandler : public HandlerBase
+    {
+    public:
+        void error(const SAXParseException& err) override
+        {
+            throw err;
+        }
+    };
+}
+
+DOMDocument* DocumentLoader::Load(const std::string& filename,
+        const Options& options, Stats& stats)
+{
+    // Configure the parser
+    XercesDOMParser parser;
+    parser.setValidationScheme(options.validate ?
+            XercesDOMParser::Val_Auto : XercesDOMParser::Val_Never);
+    parser.setDoNamespaces(options.namespaces);
+    parser.setDoSchema(options.validate && options.namespaces);
+
+    LoadErrorHandler error_handler;
+    parser.setErrorHandler(&error_handler);
+
+    ParseFile(filename, options, stats, [&parser](const InputSource& source)
+    {
+        parser.parse(source);
+    });
+
+    // Take ownership of the document away from the parser, which would
+    //      otherwise release it when it falls out of scope
+    DOMDocument* document = parser.adoptDocument();
+
+    if (!document)
+    {
+        throw std::runtime_error("The parser did not produce a document.");
+    }
+
+    return document;
+}
+
+void DocumentLoader::ParseFile(const std::string& filename,
+        const Options& options, Stats& stats,
+        const std::function<void(const InputSource&)>& parse)
+{
+    // Check the file first; this also reports a missing file more clearly
+    //      than the parser would. The mapping must outlive the parse.
+    MappedFile file(filename, options.memory_map);
+
+    stats.bytes = file.FileSize();
+    stats.mapped = file.IsMapped();
+
+    const auto start = chrono::steady_clock::now();
+
+    try
+    {
+        if (file.IsMapped())
+        {
+            MemBufInputSource source(
+                    reinterpret_cast<const XMLByte*>(file.Data()),
+                    file.Size(), filename.c_str());
+
+            // Read straight from the mapping instead of a copy of it
+            source.setCopyBufToStream(false);
+            parse(source);
+        }
+
+        // Pipes and other files that can't be mapped are read as a stream
+        else
+        {
+            LocalFileInputSource source(XSTR(filename));
+            parse(source);
+        }
+    }
+
+    // Report the location of syntax and validation errors
+    catch (const SAXParseException& err)
+    {
+        ostringstream message;
+        message << "Error at line " << err.getLineNumber() << ", column "
+                << err.getColumnNumber() << ": " << LSTR(err.getMessage());
+        throw std::runtime_error(message.str());
+    }
+
+    catch (const XMLException& err)
+    {
+        throw std::runtime_error(string("Error reading the document: ")
+                + LSTR(err.getMessage()));
+    }
+
+    catch (const DOMException& err)
+    {
+        throw std::runtime_error(string("Error building the document: ")
+                + LSTR(err.getMessage()));
+    }
+
+    stats.seconds = chrono::duration<double>(
+            chrono::steady_clock::now() - start).count();
+}
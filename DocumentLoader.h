@@ -0,0 +1,124 @@
+/*
+ * File:    DocumentLoader.h
+ * Author:  Conor Finegan
+ * Contact: conor_finegan@student.uml.edu
+ *
+ * Created on October 17, 2026
+ */
+
+#ifndef DOCUMENTLOADER_H
+#define	DOCUMENTLOADER_H
+
+#include "LocalStr.h"
+#include "XStr.h"
+#include "MappedFile.h"
+
+#include <xercesc/util/PlatformUtils.hpp>
+#include <xercesc/util/OutOfMemoryException.hpp>
+#include <xercesc/dom/DOM.hpp>
+#include <xercesc/parsers/XercesDOMParser.hpp>
+#include <xercesc/framework/MemBufInputSource.hpp>
+#include <xercesc/framework/LocalFileInputSource.hpp>
+#include <xercesc/sax/HandlerBase.hpp>
+#include <xercesc/sax/SAXParseException.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <string>
+
+/**
+ * The \c DocumentLoader class parses XML files into DOM documents using
+ *      \c XercesDOMParser. It is far faster to load an existing document
+ *      than to rebuild it from a script of "add" commands.
+ * @author Conor Finegan<br>conor_finegan@student.uml.edu
+ * @version 1.0
+ */
+class DocumentLoader final
+{
+public:
+
+    /**
+     * Parser settings. Validation and namespace processing are on by
+     *      default; turning them off makes parsing faster.
+     */
+    struct Options
+    {
+        /**
+         * Validate the document if it specifies a grammar (DTD or schema).
+         */
+        bool validate = true;
+
+        /**
+         * Process namespaces (and, with \c validate, XML Schema).
+         */
+        bool namespaces = true;
+
+        /**
+         * Parse regular files straight from a memory mapping rather than
+         *      reading them through a buffer.
+         */
+        bool memory_map = true;
+    };
+
+    /**
+     * Measurements taken while loading a document.
+     */
+    struct Stats
+    {
+        /**
+         * Size of the file that was parsed, in bytes. Zero if the file is
+         *      not a regular file (such as a pipe), as its size isn't known.
+         */
+        std::uint64_t bytes = 0;
+
+        /** \c true if the file was parsed from a memory mapping. */
+        bool mapped = false;
+
+        /** Time spent parsing, in seconds. */
+        double seconds = 0.0;
+    };
+
+    /**
+     * Parses an XML file.
+     * @param filename Path to the file to parse.
+     * @param options  Parser settings.
+     * @param stats    Receives the size of the file and the parse time.
+     * @return The parsed document. The caller owns the document and must
+     *      \c release() it.
+     * @throw std::runtime_error If the file can't be read, or is not
+     *      well-formed (or not valid, when validating). The message
+     *      describes the problem.
+     */
+    static XERCES_CPP_NAMESPACE::DOMDocument* Load(const std::string& filename,
+            const Options& options, Stats& stats);
+
+    /**
+     * Opens an XML file as an input source, memory-mapped if possible, and
+     *      hands it to \c parse, which runs any Xerces parser over it. Parse
+     *      errors thrown by the parser are turned into exceptions describing
+     *      the problem. Load() is built on this method; it is public so that
+     *      other kinds of parser (such as SAX2) can share it.
+     * @param filename Path to the file to parse.
+     * @param options  Only \c memory_map is used; the caller configures its
+     *      parser from the rest.
+     * @param stats    Receives the size of the file and the parse time.
+     * @param parse    Parses the input source it is given.
+     * @throw std::runtime_error If the file can't be read, or \c parse
+     *      throws a Xerces exception.
+     */
+    static void ParseFile(const std::string& filename, const Options& options,
+            Stats& stats, const std::function<void(
+                    const XERCES_CPP_NAMESPACE::InputSource&)>& parse);
+
+private:
+
+    /**
+     * Construction of \c DocumentLoader objects is prohibited, as this class
+     *      contains only static data.
+     */
+    DocumentLoader() = delete;
+};
+
+#endif	/* DOCUMENTLOADER_H */
+
@@ -0,0 +1,394 @@
+/*
+ * File:    DocumentStreamer.cpp
+ * Author:  Conor Finegan
+ * Contact: conor_finegan@student.uml.edu
+ *
+ * Created on October 17, 2026
+ */
+
+#include "DocumentStreamer.h"
+
+#include <memory>
+
+using namespace std;
+XERCES_CPP_NAMESPACE_USE
+
+namespace
+{
+    /**
+     * Text as it arrives from the parser. SAX2 character data is not null
+     *      terminated, so it is copied into one of these before use.
+     */
+    typedef basic_string<XMLCh> XMLText;
+    
+    /**
+     * Spaces per level of indentation; the same as DOMUtil::AppendNode().
+     */
+    constexpr size_t tab_size = 4;
+    
+    /**
+     * Output is written to the stream whenever this much has been buffered.
+     */
+    constexpr size_t flush_threshold = 64 * 1024;
+    
+    /**
+     * Counts the elements, attributes and matches of a document, and tracks
+     *      the depth of the current element. Validation errors are thrown,
+     *      as they are when loading a document.
+     */
+    class CountHandler : public DefaultHandler
+    {
+    public:
+        
+        CountHandler(const std::string& name, DocumentStreamer::Result& result)
+                : target(name), match_all(name.empty()), result(result)
+        {
+        }
+        
+        void startElement(const XMLCh* const uri, const XMLCh* const localname,
+                const XMLCh* const qname, const Attributes& attrs) override
+        {
+            ++ depth;
+            ++ result.elements;
+            result.attributes += attrs.getLength();
+            
+            if (depth > result.max_depth) { result.max_depth = depth; }
+            if (IsMatch(qname)) { ++ result.matches; }
+        }
+        
+        void endElement(const XMLCh* const uri, const XMLCh* const localname,
+                const XMLCh* const qname) override
+        {
+            -- depth;
+        }
+        
+        void error(const SAXParseException& err) override
+        {
+            throw err;
+        }
+        
+    protected:
+        
+        bool IsMatch(const XMLCh* const qname)
+        {
+            return match_all || 
+                    XMLString::equals(qname, target.get_unicode_form());
+        }
+        
+        /** Name of the elements being looked for. */
+        XStr target;
+        
+        /** \c true if no name was given, so every element matches. */
+        const bool match_all;
+        
+        /** Receives the counts. */
+        DocumentStreamer::Result& result;
+        
+        /** Depth of the current element; zero outside the root. */
+        size_t depth = 0;
+    };
+    
+    /**
+     * Prints the nodes of a document as they are parsed. A node's line can't
+     *      be written as soon as the node starts, because an element's first
+     *      text child is printed on the same line as the element, so each
+     *      node is held as "pending" until the next event shows that it is
+     *      complete.
+     */
+    class PrintHandler : public CountHandler
+    {
+    public:
+        
+        PrintHandler(const std::string& name, DocumentStreamer::Result& result,
+                std::ostream& out) : CountHandler(name, result), out(out), 
+                printing(name.empty()), base(name.empty() ? 2 : 0)
+        {
+        }
+        
+        void startElement(const XMLCh* const uri, const XMLCh* const localname,
+                const XMLCh* const qname, const Attributes& attrs) override
+        {
+            FlushPending();
+            CountHandler::startElement(uri, localname, qname, attrs);
+            
+            // Begin a sub-tree at a match that isn't inside another one
+            if (!printing && IsMatch(qname))
+            {
+                printing = true;
+                base = depth;
+            }
+            
+            if (!printing || depth < base) { return; }
+            
+            pending = Pending::Element;
+            pending_depth = depth - base;
+            pending_name.clear();
+            DOMUtil::AppendLocalForm(pending_name, qname);
+            
+            // Attributes are complete already, so format them now
+            const size_t inner_indent = (pending_depth + 1) * tab_size;
+            const XMLSize_t attrs_len = attrs.getLength();
+            
+            for (XMLSize_t i = 0; i < attrs_len; ++ i)
+            {
+                pending_attributes.append(inner_indent, ' ');
+                pending_attributes += "[Attribute] ";
+                DOMUtil::AppendLocalForm(pending_attributes, attrs.getQName(i));
+                pending_attributes += ": ";
+                DOMUtil::AppendLocalForm(pending_attributes, attrs.getValue(i));
+                pending_attributes += '\n';
+            }
+        }
+        
+        void endElement(const XMLCh* const uri, const XMLCh* const localname,
+                const XMLCh* const qname) override
+        {
+            FlushPending();
+            
+            // The sub-tree ends with the match that began it
+            if (!match_all && printing && depth == base) { printing = false; }
+            
+            CountHandler::endElement(uri, localname, qname);
+        }
+        
+        void characters(const XMLCh* const chars, 
+                const XMLSize_t length) override
+        {
+            // The first text child of an element, and adjacent chunks of a
+            //      text node, join the pending node
+            if (pending != Pending::None)
+            {
+                pending_text.append(chars, length);
+            }
+            
+            // Other text is only printed as a node of its own among the
+            //      children of the root (as the "print" command does)
+            else if (!in_cdata && printing && depth + 1 == base)
+            {
+                StartValueNode("#text");
+                pending_text.assign(chars, length);
+            }
+        }
+        
+        void ignorableWhitespace(const XMLCh* const chars, 
+                const XMLSize_t length) override
+        {
+            // The DOM parser keeps ignorable white-space, so print it too
+            characters(chars, length);
+        }
+        
+        void comment(const XMLCh* const chars, const XMLSize_t length) override
+        {
+            FlushPending();
+            
+            if (printing && depth + 1 >= base)
+            {
+                StartValueNode("#comment");
+                pending_text.assign(chars, length);
+                FlushPending();
+            }
+        }
+        
+        void processingInstruction(const XMLCh* const target, 
+                const XMLCh* const data) override
+        {
+            FlushPending();
+            
+            if (printing && depth + 1 >= base)
+            {
+                StartValueNode("");
+                DOMUtil::AppendLocalForm(pending_name, target);
+                pending_text.assign(data);
+                FlushPending();
+            }
+        }
+        
+        void startCDATA() override
+        {
+            FlushPending();
+            in_cdata = true;
+            
+            if (printing && depth + 1 >= base)
+            {
+                StartValueNode("#cdata-section");
+            }
+        }
+        
+        void endCDATA() override
+        {
+            FlushPending();
+            in_cdata = false;
+        }
+        
+        /**
+         * Prints the pending node, if any, and writes out everything that
+         *      has been buffered.
+         */
+        void Finish()
+        {
+            FlushPending();
+            Flush();
+            out.flush();
+        }
+        
+    private:
+        
+        /**
+         * Kinds of node that can be pending.
+         */
+        enum class Pending
+        {
+            None,
+            Element,
+            Value   // A text, CDATA, comment or processing instruction node
+        };
+        
+        /**
+         * Makes a node that is printed with a value (rather than text and
+         *      attributes) the pending node.
+         * @param name Name of the node.
+         */
+        void StartValueNode(const char* name)
+        {
+            pending = Pending::Value;
+            pending_depth = depth + 1 - base;
+            pending_name = name;
+        }
+        
+        /**
+         * Prints the pending node in the format of DOMUtil::AppendNode(),
+         *      including the missing line break after a value.
+         */
+        void FlushPending()
+        {
+            if (pending == Pending::None) { return; }
+            
+            const size_t indent = pending_depth * tab_size;
+            
+            buffer.append(indent, ' ');
+            buffer += "[Node] ";
+            buffer += pending_name;
+            
+            if (pending == Pending::Element)
+            {
+                if (!pending_text.empty())
+                {
+                    buffer += ": ";
+                    DOMUtil::AppendLocalForm(buffer, pending_text.c_str());
+                }
+                
+                buffer += '\n';
+                buffer += pending_attributes;
+            }
+            
+            else
+            {
+                buffer += '\n';
+                buffer.append(indent + tab_size, ' ');
+                buffer += "[Value] ";
+                DOMUtil::AppendLocalForm(buffer, pending_text.c_str());
+            }
+            
+            pending = Pending::None;
+            pending_text.clear();
+            pending_attributes.clear();
+            ++ result.printed;
+            
+            if (buffer.size() >= flush_threshold) { Flush(); }
+        }
+        
+        /**
+         * Writes out everything that has been buffered.
+         */
+        void Flush()
+        {
+            out.write(buffer.data(), buffer.size());
+            buffer.clear();
+        }
+        
+        /** Stream the document is printed to. */
+        std::ostream& out;
+        
+        /** Formatted output not yet written to \c out. */
+        std::string buffer;
+        
+        /** \c true while inside a sub-tree being printed. */
+        bool printing;
+        
+        /** Depth of elements printed without indentation. */
+        size_t base;
+        
+        /** \c true between the start and end of a CDATA section. */
+        bool in_cdata = false;
+        
+        /** Kind of node waiting to be printed. */
+        Pending pending = Pending::None;
+        
+        /** Indentation level of the pending node. */
+        size_t pending_depth = 0;
+        
+        /** Name of the pending node, in local form. */
+        std::string pending_name;
+        
+        /** Text or value of the pending node. */
+        XMLText pending_text;
+        
+        /** Formatted attributes of the pending element. */
+        std::string pending_attributes;
+    };
+}
+
+void DocumentStreamer::Print(const std::string& filename, 
+        const std::string& name, const DocumentLoader::Options& options,
+        std::ostream& out, Result& result)
+{
+    PrintHandler handler(name, result, out);
+    
+    // Output for the part of the document before an error still goes out
+    try
+    {
+        Stream(filename, options, handler, result.stats);
+    }
+    catch (const std::runtime_error&)
+    {
+        handler.Finish();
+        throw;
+    }
+    
+    handler.Finish();
+}
+
+void DocumentStreamer::Count(const std::string& filename, 
+        const std::string& name, const DocumentLoader::Options& options,
+        Result& result)
+{
+    CountHandler handler(name, result);
+    Stream(filename, options, handler, result.stats);
+}
+
+void DocumentStreamer::Stream(const std::string& filename, 
+        const DocumentLoader::Options& options, DefaultHandler& handler, 
+        DocumentLoader::Stats& stats)
+{
+    unique_ptr<SAX2XMLReader> reader(XMLReaderFactory::createXMLReader());
+    
+    // Match the settings DocumentLoader gives the DOM parser
+    reader->setFeature(XMLUni::fgSAX2CoreNameSpaces, options.namespaces);
+    reader->setFeature(XMLUni::fgSAX2CoreValidation, options.validate);
+    reader->setFeature(XMLUni::fgXercesDynamic, true);
+    reader->setFeature(XMLUni::fgXercesSchema, 
+            options.validate && options.namespaces);
+    
+    // The DOM keeps namespace declarations as attributes, so report them
+    reader->setFeature(XMLUni::fgSAX2CoreNameSpacePrefixes, true);
+    
+    reader->setContentHandler(&handler);
+    reader->setLexicalHandler(&handler);
+    reader->setErrorHandler(&handler);
+    
+    DocumentLoader::ParseFile(filename, options, stats, 
+            [&reader](const InputSource& source)
+            {
+                reader->parse(source);
+            });
+}
@@ -0,0 +1,123 @@
+/*
+ * File:    DocumentStreamer.h
+ * Author:  Conor Finegan
+ * Contact: conor_finegan@student.uml.edu
+ *
+ * Created on October 17, 2026
+ */
+
+#ifndef DOCUMENTSTREAMER_H
+#define	DOCUMENTSTREAMER_H
+
+#include "DocumentLoader.h"
+#include "DOMUtil.h"
+#include "XStr.h"
+
+#include <xercesc/sax2/SAX2XMLReader.hpp>
+#include <xercesc/sax2/XMLReaderFactory.hpp>
+#include <xercesc/sax2/DefaultHandler.hpp>
+#include <xercesc/sax2/Attributes.hpp>
+#include <xercesc/util/XMLUni.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+/**
+ * The \c DocumentStreamer class inspects XML files with a SAX2 parser rather
+ *      than loading them into a DOM document, so that files larger than
+ *      memory can still be printed and queried. Memory use depends on the
+ *      depth of the document and the size of its largest text node, not on
+ *      the size of the document.
+ * @author Conor Finegan<br>conor_finegan@student.uml.edu
+ * @version 1.0
+ */
+class DocumentStreamer final
+{
+public:
+    
+    /**
+     * What was found while streaming a document.
+     */
+    struct Result
+    {
+        /** Number of elements in the document. */
+        std::uint64_t elements = 0;
+        
+        /**
+         * Number of elements with the requested name, or of all elements if
+         *      no name was given.
+         */
+        std::uint64_t matches = 0;
+        
+        /** Number of attributes in the document. */
+        std::uint64_t attributes = 0;
+        
+        /** Depth of the most deeply nested element; the root is at 1. */
+        std::size_t max_depth = 0;
+        
+        /** Number of nodes printed by Print(). */
+        std::uint64_t printed = 0;
+        
+        /** Size of the file and time taken to stream it. */
+        DocumentLoader::Stats stats;
+    };
+    
+    /**
+     * Prints a file in the same format as \c DOMUtil::AppendDocSubTree().
+     *      With no name, the children of the root are printed, as for the
+     *      "print" command. Otherwise every element with the given name is
+     *      printed as the root of a sub-tree; an element nested inside
+     *      another match is printed as part of the outer match only.
+     * @param filename Path to the file to print.
+     * @param name     Name of the elements to print, or empty to print the
+     *      whole document.
+     * @param options  Parser settings.
+     * @param out      Stream to print to. Output is written in blocks as the
+     *      file is parsed.
+     * @param result   Receives what was found in the document.
+     * @throw std::runtime_error If the file can't be read or parsed. Output
+     *      for the part of the file before the error will have been written.
+     */
+    static void Print(const std::string& filename, const std::string& name,
+            const DocumentLoader::Options& options, std::ostream& out, 
+            Result& result);
+    
+    /**
+     * Counts the elements of a file without printing anything.
+     * @param filename Path to the file to count.
+     * @param name     Name of the elements to count as matches, or empty to
+     *      count every element.
+     * @param options  Parser settings.
+     * @param result   Receives what was found in the document.
+     * @throw std::runtime_error If the file can't be read or parsed.
+     */
+    static void Count(const std::string& filename, const std::string& name,
+            const DocumentLoader::Options& options, Result& result);
+    
+private:
+    
+    /**
+     * Construction of \c DocumentStreamer objects is prohibited, as this
+     *      class contains only static data.
+     */
+    DocumentStreamer() = delete;
+    
+    /**
+     * Runs a SAX2 parser configured from \c options over a file, reporting
+     *      to \c handler.
+     * @param filename Path to the file to parse.
+     * @param options  Parser settings.
+     * @param handler  Receives the content, lexical and error events.
+     * @param stats    Receives the size of the file and the parse time.
+     * @throw std::runtime_error If the file can't be read or parsed.
+     */
+    static void Stream(const std::string& filename, 
+            const DocumentLoader::Options& options, 
+            XERCES_CPP_NAMESPACE::DefaultHandler& handler, 
+            DocumentLoader::Stats& stats);
+};
+
+#endif	/* DOCUMENTSTREAMER_H */
+
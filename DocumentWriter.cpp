@@ -0,0 +1,657 @@
+/*
+ * File:    DocumentWriter.cpp
+ * Author:  Conor Finegan
+ * Contact: conor_finegan@student.uml.edu
+ *
+ * Created on October 17, 2026
+ */
+
+#include "DocumentWriter.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <system_error>
+#include <thread>
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <unistd.h>
+
+using namespace std;
+XERCES_CPP_NAMESPACE_USE
+
+constexpr std::size_t DocumentWriter::DEFAULT_BUFFER_SIZE;
+
+namespace
+{
+    /**
+     * Average number of batches of children per thread. More batches even
+     *      out the threads' work; fewer cost less to hand out.
+     */
+    const size_t BATCHES_PER_THREAD = 8;
+    
+    /**
+     * Depth beyond which a document is written on a thread whose stack is
+     *      sized for it. The serializer recurses once per level, so deeper
+     *      documents could overflow a default stack.
+     */
+    const size_t DEEP_DOCUMENT_DEPTH = 1000;
+    
+    /**
+     * Stack reserved per level of a deep document.
+     */
+    const size_t STACK_PER_LEVEL = 4096;
+    
+    /**
+     * Collects serialized output in memory.
+     */
+    class StringFormatTarget : public XMLFormatTarget
+    {
+    public:
+        
+        explicit StringFormatTarget(string& buffer) : buffer(buffer) {}
+        
+        void writeChars(const XMLByte* const toWrite, const XMLSize_t count,
+                XMLFormatter* const formatter) override
+        {
+            buffer.append(reinterpret_cast<const char*>(toWrite), count);
+        }
+        
+    private:
+        
+        string& buffer;
+    };
+    
+    /**
+     * Leaves the children of one element out of the output.
+     */
+    class SkipChildrenFilter : public DOMLSSerializerFilter
+    {
+    public:
+        
+        explicit SkipChildrenFilter(const DOMNode* parent) : parent(parent) {}
+        
+        FilterAction acceptNode(const DOMNode* node) const override
+        {
+            return (node->getParentNode() == parent) ?
+                    FILTER_REJECT : FILTER_ACCEPT;
+        }
+        
+        ShowType getWhatToShow() const override
+        {
+            return DOMNodeFilter::SHOW_ALL;
+        }
+        
+    private:
+        
+        const DOMNode* const parent;
+    };
+    
+    /**
+     * A task run by RunOnLargeStack(), and the error it ended with.
+     */
+    struct StackTask
+    {
+        const function<void()>& task;
+        exception_ptr error;
+    };
+    
+    /**
+     * Entry point of the threads started by RunOnLargeStack().
+     */
+    void* RunStackTask(void* arg)
+    {
+        StackTask& stack_task = *static_cast<StackTask*>(arg);
+        
+        try
+        {
+            stack_task.task();
+        }
+        
+        catch (...)
+        {
+            stack_task.error = current_exception();
+        }
+        
+        return nullptr;
+    }
+    
+    /**
+     * Runs a task on a new thread with a stack of the given size, and waits
+     *      for it. If no such thread can be started, the task runs on the
+     *      calling thread instead. Errors of the task are passed on.
+     */
+    void RunOnLargeStack(const size_t stack_size, const function<void()>& task)
+    {
+        StackTask stack_task{ task, nullptr };
+        pthread_attr_t attr;
+        pthread_t worker;
+        bool started = false;
+        
+        if (pthread_attr_init(&attr) == 0)
+        {
+            started = pthread_attr_setstacksize(&attr, stack_size) == 0 &&
+                    pthread_create(&worker, &attr, RunStackTask, 
+                    &stack_task) == 0;
+            pthread_attr_destroy(&attr);
+        }
+        
+        if (!started)
+        {
+            task();
+            return;
+        }
+        
+        pthread_join(worker, nullptr);
+        
+        if (stack_task.error)
+        {
+            rethrow_exception(stack_task.error);
+        }
+    }
+    
+    /**
+     * Writes a part of a buffer to a format target.
+     */
+    void WriteBuffer(XMLFormatTarget& target, const string& buffer,
+            const size_t start, const size_t count)
+    {
+        if (count > 0)
+        {
+            target.writeChars(reinterpret_cast<const XMLByte*>(
+                    buffer.data() + start), count, nullptr);
+        }
+    }
+}
+
+void DocumentWriter::Write(DOMImplementation* impl, const DOMNode* document,
+        const std::string& destination, const Options& options, Stats& stats)
+{
+    // Get serializer and output description from DOM implementation
+    LSSerializerPtr serializer = CreateSerializer(impl, options.pretty);
+    LSOutputPtr output_desc(impl->createLSOutput());
+    
+    if (!output_desc)
+    {
+        throw std::runtime_error("The serializer could not be created.");
+    }
+    
+    // Choose a compression format, by extension unless one was given
+    CompressedFormatTarget::Algorithm algorithm = 
+            CompressedFormatTarget::Algorithm::Gzip;
+    
+    switch (options.compression)
+    {
+    case Compression::Auto:
+        stats.compressed = destination != "-" && 
+                CompressedFormatTarget::FromFileName(destination, algorithm);
+        break;
+        
+    case Compression::None:
+        stats.compressed = false;
+        break;
+        
+    case Compression::Gzip:
+        stats.compressed = true;
+        break;
+        
+    case Compression::Zstd:
+        stats.compressed = true;
+        algorithm = CompressedFormatTarget::Algorithm::Zstd;
+        break;
+    }
+    
+    if (stats.compressed && !CompressedFormatTarget::IsAvailable(algorithm))
+    {
+        throw std::runtime_error("zstd compression is not available in this "
+                "build.");
+    }
+    
+    bool owns_fd = false;
+    FdFormatTarget target(OpenDestination(destination, owns_fd), 
+            options.buffer_size, owns_fd);
+    
+    // Compressed output passes through the compressor on its way to the file
+    unique_ptr<CompressedFormatTarget> compressor;
+    
+    if (stats.compressed)
+    {
+        compressor.reset(new CompressedFormatTarget(target, algorithm));
+    }
+    
+    XMLFormatTarget& sink = compressor ? 
+            static_cast<XMLFormatTarget&>(*compressor) : target;
+    output_desc->setByteStream(&sink);
+    
+    const auto start = chrono::steady_clock::now();
+    
+    // Deep documents are written by a single thread with a stack to match
+    const size_t depth = Depth(document);
+    
+    if (depth > DEEP_DOCUMENT_DEPTH)
+    {
+        stats.threads = 1;
+        RunOnLargeStack(depth * STACK_PER_LEVEL, [&]()
+        {
+            Serialize(serializer.get(), output_desc.get(), document);
+        });
+    }
+    
+    // Documents that can't be split between threads are written by this one
+    else
+    {
+        stats.threads = (options.threads > 1 && !options.pretty) ?
+                WriteParallel(impl, document, sink, options.threads) : 0;
+        
+        if (stats.threads == 0)
+        {
+            stats.threads = 1;
+            Serialize(serializer.get(), output_desc.get(), document);
+        }
+    }
+    
+    // Finish and close before stopping the clock; the last of the output is
+    //      written here
+    const bool compress_result = !compressor || compressor->Finish();
+    const bool close_result = target.Close();
+    
+    stats.bytes = target.BytesWritten();
+    stats.bytes_in = compressor ? compressor->BytesIn() : stats.bytes;
+    stats.seconds = chrono::duration<double>(
+            chrono::steady_clock::now() - start).count();
+    
+    if (!compress_result)
+    {
+        throw std::runtime_error("Error compressing the output.");
+    }
+    
+    if (!close_result)
+    {
+        throw std::runtime_error(string("Error writing the output: ") 
+                + strerror(target.Error()));
+    }
+}
+
+int DocumentWriter::OpenDestination(const std::string& destination, 
+        bool& owns_fd)
+{
+    const string fd_prefix = "fd:";
+    
+    // Standard output; anything already written through cout goes first
+    if (destination == "-")
+    {
+        cout.flush();
+        owns_fd = false;
+        return STDOUT_FILENO;
+    }
+    
+    // A descriptor opened by someone else
+    if (destination.compare(0, fd_prefix.size(), fd_prefix) == 0)
+    {
+        const string number = destination.substr(fd_prefix.size());
+        char* endptr = nullptr;
+        errno = 0;
+        const long fd = strtol(number.c_str(), &endptr, 10);
+        
+        if (number.empty() || *endptr != 0 || errno == ERANGE || fd < 0 ||
+                fd > INT_MAX || fcntl(static_cast<int>(fd), F_GETFD) < 0)
+        {
+            throw std::runtime_error("Not an open file descriptor: \"" 
+                    + destination + "\"");
+        }
+        
+        owns_fd = false;
+        return static_cast<int>(fd);
+    }
+    
+    // Otherwise a file, created or truncated
+    const int fd = open(destination.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 
+            0666);
+    
+    if (fd < 0)
+    {
+        throw std::runtime_error(string("Could not open the file: ") 
+                + strerror(errno));
+    }
+    
+    owns_fd = true;
+    return fd;
+}
+
+LSSerializerPtr DocumentWriter::CreateSerializer(DOMImplementation* impl,
+        const bool pretty)
+{
+    LSSerializerPtr serializer(impl->createLSSerializer());
+    
+    if (!serializer)
+    {
+        throw std::runtime_error("The serializer could not be created.");
+    }
+    
+    if (pretty)
+    {
+        DOMConfiguration* config = serializer->getDomConfig();
+        
+        if (config->canSetParameter(XMLUni::fgDOMWRTFormatPrettyPrint, true))
+        {
+            config->setParameter(XMLUni::fgDOMWRTFormatPrettyPrint, true);
+        }
+    }
+    
+    return serializer;
+}
+
+void DocumentWriter::Serialize(DOMLSSerializer* serializer,
+        DOMLSOutput* output_desc, const DOMNode* node)
+{
+    bool write_result = false;
+    
+    try
+    {
+        write_result = serializer->write(node, output_desc);
+    }
+    
+    catch (const XMLException& err)
+    {
+        throw std::runtime_error(string("Error serializing the document: ")
+                + LSTR(err.getMessage()));
+    }
+    
+    catch (const DOMException& err)
+    {
+        throw std::runtime_error(string("Error serializing the document: ")
+                + LSTR(err.getMessage()));
+    }
+    
+    if (!write_result)
+    {
+        throw std::runtime_error("The serializer reported an error.");
+    }
+}
+
+std::size_t DocumentWriter::WriteParallel(DOMImplementation* impl,
+        const DOMNode* document, XMLFormatTarget& target,
+        const std::size_t threads)
+{
+    if (document->getNodeType() != DOMNode::DOCUMENT_NODE)
+    {
+        return 0;
+    }
+    
+    const DOMDocument* const doc = static_cast<const DOMDocument*>(document);
+    const DOMElement* const root = doc->getDocumentElement();
+    
+    // The root's end tag has to be the last thing written
+    if (!root || root->getNextSibling() || !IsSelfContained(root, false))
+    {
+        return 0;
+    }
+    
+    // The serializer writes in the document's own encoding, if it has one
+    for (const XMLCh* encoding : { doc->getInputEncoding(),
+            doc->getXmlEncoding() })
+    {
+        if (encoding && *encoding && XMLString::compareIString(encoding,
+                XMLUni::fgUTF8EncodingString) != 0)
+        {
+            return 0;
+        }
+    }
+    
+    vector<const DOMNode*> children;
+    
+    for (const DOMNode* child = root->getFirstChild(); child;
+            child = child->getNextSibling())
+    {
+        children.push_back(child);
+    }
+    
+    if (children.size() < 2)
+    {
+        return 0;
+    }
+    
+    // The document without the root's children. They go just before the
+    //      root's end tag, which is the last tag in it.
+    string outline;
+    
+    {
+        LSSerializerPtr serializer = CreateSerializer(impl, false);
+        LSOutputPtr output_desc(impl->createLSOutput());
+        
+        if (!output_desc)
+        {
+            throw std::runtime_error("The serializer could not be created.");
+        }
+        
+        StringFormatTarget outline_target(outline);
+        SkipChildrenFilter filter(root);
+        
+        serializer->setFilter(&filter);
+        output_desc->setByteStream(&outline_target);
+        Serialize(serializer.get(), output_desc.get(), document);
+    }
+    
+    const size_t split = outline.rfind("</");
+    
+    if (split == string::npos || outline.back() != '>')
+    {
+        return 0;
+    }
+    
+    // Consecutive children are grouped into batches, and each thread takes
+    //      the next batch as soon as it finishes one. Every buffer is written
+    //      by exactly one thread.
+    const size_t workers = min(threads, children.size());
+    const size_t batch_size = max<size_t>(
+            children.size() / (workers * BATCHES_PER_THREAD), 1);
+    vector<string> batches((children.size() + batch_size - 1) / batch_size);
+    
+    atomic<size_t> next(0);
+    atomic<bool> split_failed(false);
+    mutex error_mutex;
+    string error;
+    
+    // Each thread has a serializer of its own, but they all read the one
+    //      document, without a lock; Xerces-C leaves that to the application.
+    //      In Xerces-C 3, serializing an element or text node only reads
+    //      fields of the nodes: names, values, attribute maps and links
+    //      between nodes. The one exception met here is an attribute value
+    //      split between several nodes, which DOMAttrImpl::getValue() joins
+    //      in the document's string pool; IsSelfContained() keeps such
+    //      subtrees on a single thread. The document can't change meanwhile,
+    //      as commands run one at a time and background writes use a copy.
+    const auto work = [&]()
+    {
+        try
+        {
+            LSSerializerPtr serializer = CreateSerializer(impl, false);
+            LSOutputPtr output_desc(impl->createLSOutput());
+            
+            if (!output_desc)
+            {
+                throw std::runtime_error("The serializer could not be "
+                        "created.");
+            }
+            
+            for (size_t i = next++; i < batches.size() && !split_failed;
+                    i = next++)
+            {
+                StringFormatTarget batch_target(batches[i]);
+                output_desc->setByteStream(&batch_target);
+                
+                const size_t end = min((i + 1) * batch_size, children.size());
+                
+                for (size_t j = i * batch_size; j < end; ++ j)
+                {
+                    if (!IsSelfContained(children[j], true))
+                    {
+                        split_failed = true;
+                        break;
+                    }
+                    
+                    Serialize(serializer.get(), output_desc.get(),
+                            children[j]);
+                }
+            }
+        }
+        
+        // The first error is reported, and the other threads stop early
+        catch (const std::exception& err)
+        {
+            lock_guard<mutex> lock(error_mutex);
+            if (error.empty()) { error = err.what(); }
+            split_failed = true;
+        }
+        
+        catch (...)
+        {
+            lock_guard<mutex> lock(error_mutex);
+            if (error.empty())
+            {
+                error = "An unspecified exception was thrown while "
+                        "serializing the document.";
+            }
+            split_failed = true;
+        }
+    };
+    
+    // The calling thread is one of the workers
+    vector<thread> pool;
+    
+    try
+    {
+        for (size_t i = 1; i < workers; ++ i)
+        {
+            pool.emplace_back(work);
+        }
+    }
+    
+    // With fewer threads than asked for, the batches still all get written
+    catch (const std::system_error&)
+    {
+    }
+    
+    work();
+    
+    for (thread& worker : pool)
+    {
+        worker.join();
+    }
+    
+    if (!error.empty())
+    {
+        throw std::runtime_error(error);
+    }
+    
+    // Nothing has been written yet, so a single thread can still take over
+    if (split_failed)
+    {
+        return 0;
+    }
+    
+    WriteBuffer(target, outline, 0, split);
+    
+    for (const string& batch : batches)
+    {
+        WriteBuffer(target, batch, 0, batch.size());
+    }
+    
+    WriteBuffer(target, outline, split, outline.size() - split);
+    
+    return pool.size() + 1;
+}
+
+bool DocumentWriter::IsSelfContained(const DOMNode* node, const bool subtree)
+{
+    // Visit the subtree in document order, without recursion
+    const DOMNode* next = node;
+    
+    while (next)
+    {
+        if (next->getNodeType() == DOMNode::ELEMENT_NODE)
+        {
+            const XMLCh* const uri = next->getNamespaceURI();
+            if (uri && *uri) { return false; }
+            
+            const DOMNamedNodeMap* const attributes = next->getAttributes();
+            
+            for (XMLSize_t i = 0; attributes && i < attributes->getLength();
+                    ++ i)
+            {
+                const DOMNode* const attribute = attributes->item(i);
+                const XMLCh* const attribute_uri =
+                        attribute->getNamespaceURI();
+                const DOMNode* const value = attribute->getFirstChild();
+                
+                if ((attribute_uri && *attribute_uri) ||
+                        XMLString::startsWith(attribute->getNodeName(),
+                        XMLUni::fgXMLNSString) ||
+                        (value && value->getNextSibling()))
+                {
+                    return false;
+                }
+            }
+        }
+        
+        if (!subtree)
+        {
+            break;
+        }
+        
+        if (next->getFirstChild())
+        {
+            next = next->getFirstChild();
+            continue;
+        }
+        
+        while (next != node && !next->getNextSibling())
+        {
+            next = next->getParentNode();
+        }
+        
+        next = (next == node) ? nullptr : next->getNextSibling();
+    }
+    
+    return true;
+}
+
+std::size_t DocumentWriter::Depth(const DOMNode* node)
+{
+    // Walks the tree without recursing, as deep trees are what it looks for
+    size_t depth = 0;
+    size_t deepest = 0;
+    const DOMNode* next = node;
+    
+    while (next)
+    {
+        deepest = max(deepest, depth);
+        
+        if (next->getFirstChild())
+        {
+            next = next->getFirstChild();
+            ++ depth;
+            continue;
+        }
+        
+        while (next != node && !next->getNextSibling())
+        {
+            next = next->getParentNode();
+            -- depth;
+        }
+        
+        next = (next == node) ? nullptr : next->getNextSibling();
+    }
+    
+    return deepest;
+}
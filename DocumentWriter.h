@@ -0,0 +1,214 @@
+/*
+ * File:    DocumentWriter.h
+ * Author:  Conor Finegan
+ * Contact: conor_finegan@student.uml.edu
+ *
+ * Created on October 17, 2026
+ */
+
+#ifndef DOCUMENTWRITER_H
+#define	DOCUMENTWRITER_H
+
+#include "PointerTypedefs.h"
+#include "LocalStr.h"
+#include "FdFormatTarget.h"
+#include "CompressedFormatTarget.h"
+
+#include <xercesc/dom/DOM.hpp>
+#include <xercesc/util/XMLUni.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * The \c DocumentWriter class serializes DOM documents with
+ *      \c DOMLSSerializer, writing through an \c FdFormatTarget so that the
+ *      output buffer can be sized for large documents, and so that output
+ *      can go to standard out or to an open file descriptor as well as to a
+ *      file. Output can also be compressed on the way out through a
+ *      \c CompressedFormatTarget. Wide documents can be serialized by
+ *      several threads at once; see \c Options::threads.
+ * @author Conor Finegan<br>conor_finegan@student.uml.edu
+ * @version 1.0
+ */
+class DocumentWriter final
+{
+public:
+    
+    /**
+     * Default size of the output buffer, in bytes.
+     */
+    static constexpr std::size_t DEFAULT_BUFFER_SIZE = 1024 * 1024;
+    
+    /**
+     * How output is compressed.
+     */
+    enum class Compression
+    {
+        Auto,   // Chosen by the destination's extension (".gz" or ".zst")
+        None,
+        Gzip,
+        Zstd
+    };
+    
+    /**
+     * Serializer settings.
+     */
+    struct Options
+    {
+        /**
+         * Indent the output. Off by default, which reproduces the document
+         *      exactly as it is held in memory.
+         */
+        bool pretty = false;
+        
+        /**
+         * Size of the output buffer, in bytes.
+         */
+        std::size_t buffer_size = DEFAULT_BUFFER_SIZE;
+        
+        /**
+         * How to compress the output.
+         */
+        Compression compression = Compression::Auto;
+        
+        /**
+         * Number of threads that serialize the document. With more than
+         *      one, the children of the root element are handed out to the
+         *      threads in small batches, each serialized into a buffer of its
+         *      own, and the buffers are written out in document order. The
+         *      output is byte-identical to that of a single thread. Documents
+         *      that can't be split this way are written by a single thread:
+         *      pretty-printed output, documents that use namespaces or are
+         *      not encoded in UTF-8, entity references in attribute values,
+         *      anything after the root element, and roots with fewer than
+         *      two children.
+         */
+        std::size_t threads = 1;
+    };
+    
+    /**
+     * Measurements taken while writing a document.
+     */
+    struct Stats
+    {
+        /** Number of bytes written, after compression. */
+        std::uint64_t bytes = 0;
+        
+        /** Number of bytes produced by the serializer, before compression. */
+        std::uint64_t bytes_in = 0;
+        
+        /** \c true if the output was compressed. */
+        bool compressed = false;
+        
+        /** Time spent serializing and writing, in seconds. */
+        double seconds = 0.0;
+        
+        /** Number of threads that serialized the document. */
+        std::size_t threads = 1;
+    };
+    
+    /**
+     * Serializes a document.
+     * @param impl        Implementation to create the serializer from.
+     * @param document    Document to write.
+     * @param destination Where to write: a file path, "-" for standard
+     *      output, or "fd:N" for the open file descriptor N (which is left
+     *      open).
+     * @param options     Serializer settings.
+     * @param stats       Receives the number of bytes written and the time
+     *      taken.
+     * @throw std::runtime_error If the destination can't be opened, the
+     *      serializer can't be created or reports an error, the compression
+     *      format isn't available or fails, or the output can't be written.
+     *      The message describes the problem.
+     */
+    static void Write(XERCES_CPP_NAMESPACE::DOMImplementation* impl,
+            const XERCES_CPP_NAMESPACE::DOMNode* document, 
+            const std::string& destination, const Options& options,
+            Stats& stats);
+    
+private:
+    
+    /**
+     * Construction of \c DocumentWriter objects is prohibited, as this class
+     *      contains only static data.
+     */
+    DocumentWriter() = delete;
+    
+    /**
+     * Opens the destination of a write.
+     * @param destination See Write().
+     * @param owns_fd     Receives \c true if the caller must close the
+     *      descriptor, \c false if it belongs to someone else.
+     * @return The file descriptor to write to.
+     * @throw std::runtime_error If the destination can't be opened.
+     */
+    static int OpenDestination(const std::string& destination, bool& owns_fd);
+    
+    /**
+     * Creates a serializer.
+     * @param impl   Implementation to create the serializer from.
+     * @param pretty \c true to indent the output.
+     * @return The serializer, which is never null.
+     * @throw std::runtime_error If the serializer can't be created.
+     */
+    static LSSerializerPtr CreateSerializer(
+            XERCES_CPP_NAMESPACE::DOMImplementation* impl, const bool pretty);
+    
+    /**
+     * Serializes nodes with a serializer, translating its errors.
+     * @param serializer  The serializer.
+     * @param output_desc Where the serializer writes to.
+     * @param node        Node to write.
+     * @throw std::runtime_error If the serializer fails.
+     */
+    static void Serialize(XERCES_CPP_NAMESPACE::DOMLSSerializer* serializer,
+            XERCES_CPP_NAMESPACE::DOMLSOutput* output_desc,
+            const XERCES_CPP_NAMESPACE::DOMNode* node);
+    
+    /**
+     * Serializes a document on several threads, if it can be split between
+     *      them (see \c Options::threads). Nothing is written otherwise. The
+     *      threads read the document concurrently, which is safe only for the
+     *      nodes IsSelfContained() accepts, and only while the document does
+     *      not change.
+     * @param impl     Implementation to create the serializers from.
+     * @param document Document to write.
+     * @param target   Where to write the document.
+     * @param threads  Highest number of threads to use.
+     * @return The number of threads used, or 0 if the document can't be
+     *      split and must be written by a single thread.
+     * @throw std::runtime_error If a serializer fails.
+     */
+    static std::size_t WriteParallel(
+            XERCES_CPP_NAMESPACE::DOMImplementation* impl,
+            const XERCES_CPP_NAMESPACE::DOMNode* document,
+            XERCES_CPP_NAMESPACE::XMLFormatTarget& target,
+            const std::size_t threads);
+    
+    /**
+     * Checks that a node can be serialized on its own, on any thread: it
+     *      uses no namespaces, which the serializer would declare again, and
+     *      has no attribute values split between several nodes, which are
+     *      joined in a buffer shared by the whole document.
+     * @param node    Node to check.
+     * @param subtree \c true to also check every node beneath \c node.
+     * @return \c true if none of the nodes checked stands in the way.
+     */
+    static bool IsSelfContained(const XERCES_CPP_NAMESPACE::DOMNode* node,
+            const bool subtree);
+    
+    /**
+     * Measures the depth of a tree.
+     * @param node Root of the tree.
+     * @return The number of levels below \c node on its longest branch.
+     */
+    static std::size_t Depth(const XERCES_CPP_NAMESPACE::DOMNode* node);
+};
+
+#endif	/* DOCUMENTWRITER_H */
+
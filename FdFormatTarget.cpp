@@ -0,0 +1,126 @@
+/*
+ * File:    FdFormatTarget.cpp
+ * Author:  Conor Finegan
+ * Contact: conor_finegan@student.uml.edu
+ *
+ * Created on October 17, 2026
+ */
+
+#include "FdFormatTarget.h"
+
+#include <cerrno>
+#include <cstring>
+
+#include <unistd.h>
+
+using namespace std;
+XERCES_CPP_NAMESPACE_USE
+
+namespace
+{
+    /**
+     * Number of writes in a row that may be interrupted or write nothing
+     *      before the output is given up on.
+     */
+    const size_t MAX_WRITE_RETRIES = 16;
+}
+
+FdFormatTarget::FdFormatTarget(const int fd, const std::size_t buffer_size, 
+        const bool owns_fd) : fd(fd), owns_fd(owns_fd), 
+        buffer(buffer_size > 0 ? buffer_size : 1)
+{
+}
+
+FdFormatTarget::~FdFormatTarget() noexcept
+{
+    Close();
+}
+
+void FdFormatTarget::writeChars(const XMLByte* const toWrite, 
+        const XMLSize_t count, XMLFormatter* const formatter)
+{
+    const char* const data = reinterpret_cast<const char*>(toWrite);
+    
+    // Make room if the new bytes don't fit behind what's already buffered
+    if (used + count > buffer.size())
+    {
+        flush();
+    }
+    
+    // Anything as large as the buffer would only be copied to no purpose
+    if (count >= buffer.size())
+    {
+        WriteAll(data, count);
+        return;
+    }
+    
+    memcpy(buffer.data() + used, data, count);
+    used += count;
+}
+
+void FdFormatTarget::flush()
+{
+    WriteAll(buffer.data(), used);
+    used = 0;
+}
+
+bool FdFormatTarget::Close()
+{
+    if (fd < 0) { return !Failed(); }
+    
+    flush();
+    
+    if (owns_fd && close(fd) != 0 && error == 0)
+    {
+        error = errno;
+    }
+    
+    fd = -1;
+    return !Failed();
+}
+
+bool FdFormatTarget::Failed() const
+{
+    return error != 0;
+}
+
+int FdFormatTarget::Error() const
+{
+    return error;
+}
+
+std::uint64_t FdFormatTarget::BytesWritten() const
+{
+    return bytes_written;
+}
+
+void FdFormatTarget::WriteAll(const char* data, std::size_t size)
+{
+    size_t retries = 0;
+    
+    // Once a write has failed, the rest of the output is dropped
+    while (size > 0 && error == 0)
+    {
+        const ssize_t written = write(fd, data, size);
+        
+        // Interrupted before anything was written, or nothing written at
+        //      all: try again, but not forever
+        if (written <= 0)
+        {
+            const int cause = (written < 0) ? errno : EIO;
+            
+            if ((written < 0 && cause != EINTR) ||
+                    ++ retries >= MAX_WRITE_RETRIES)
+            {
+                error = cause;
+            }
+            
+            continue;
+        }
+        
+        retries = 0;
+        data += written;
+        size -= static_cast<size_t>(written);
+        bytes_written += static_cast<uint64_t>(written);
+    }
+}
@@ -0,0 +1,142 @@
+/*
+ * File:    FdFormatTarget.h
+ * Author:  Conor Finegan
+ * Contact: conor_finegan@student.uml.edu
+ *
+ * Created on October 17, 2026
+ */
+
+#ifndef FDFORMATTARGET_H
+#define	FDFORMATTARGET_H
+
+#include <xercesc/framework/XMLFormatter.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * The \c FdFormatTarget class is a Xerces-C format target that writes to a
+ *      POSIX file descriptor through a buffer of configurable size. Unlike
+ *      \c LocalFileFormatTarget it can write to standard output or to a
+ *      descriptor opened by someone else, and a large buffer keeps the
+ *      number of \c write calls down when serializing large documents.
+ *      Write errors don't throw from inside the serializer; they are
+ *      recorded and can be checked with Failed() afterwards.
+ * @author Conor Finegan<br>conor_finegan@student.uml.edu
+ * @version 1.0
+ */
+class FdFormatTarget final : public XERCES_CPP_NAMESPACE::XMLFormatTarget
+{
+public:
+    
+    /**
+     * Constructs a format target for an open file descriptor.
+     * @param fd          Descriptor to write to.
+     * @param buffer_size Size of the output buffer in bytes. Writes at least
+     *      this large bypass the buffer.
+     * @param owns_fd     \c true to close \c fd when the target is closed.
+     */
+    FdFormatTarget(const int fd, const std::size_t buffer_size, 
+            const bool owns_fd);
+    
+    /**
+     * Disabled copy constructor \n
+     * Copying is disabled because the target may own its descriptor.
+     */
+    FdFormatTarget(const FdFormatTarget&) = delete;
+    
+    /**
+     * Disabled copy-assignment operator \n
+     * Copying is disabled because the target may own its descriptor.
+     */
+    void operator=(const FdFormatTarget&) = delete;
+    
+    /**
+     * Destructor \n
+     * Calls Close(), ignoring any error.
+     */
+    ~FdFormatTarget() noexcept;
+    
+    /**
+     * Buffers output from the serializer, writing the buffer out when it is
+     *      full.
+     * @param toWrite   Bytes to write.
+     * @param count     Number of bytes to write.
+     * @param formatter Unused.
+     */
+    void writeChars(const XMLByte* const toWrite, const XMLSize_t count,
+            XERCES_CPP_NAMESPACE::XMLFormatter* const formatter) override;
+    
+    /**
+     * Writes out everything in the buffer.
+     */
+    void flush() override;
+    
+    /**
+     * Flushes the buffer and, if the descriptor is owned, closes it. Further
+     *      calls do nothing.
+     * @return \c false if any write (or the close) failed.
+     */
+    bool Close();
+    
+    /**
+     * @return \c true if a write has failed.
+     */
+    bool Failed() const;
+    
+    /**
+     * @return The \c errno value of the first failure, or zero.
+     */
+    int Error() const;
+    
+    /**
+     * @return The number of bytes written to the descriptor so far.
+     */
+    std::uint64_t BytesWritten() const;
+    
+private:
+    
+    /**
+     * Writes a run of bytes to the descriptor, retrying partial writes.
+     *      Writes that are interrupted or write nothing are retried a bounded
+     *      number of times in a row; a descriptor that still writes nothing
+     *      fails with \c EIO. Does nothing once a write has failed.
+     * @param data Bytes to write.
+     * @param size Number of bytes to write.
+     */
+    void WriteAll(const char* data, std::size_t size);
+    
+    /**
+     * Descriptor written to, or -1 once closed.
+     */
+    int fd;
+    
+    /**
+     * \c true to close \c fd in Close().
+     */
+    const bool owns_fd;
+    
+    /**
+     * Output buffer; its size is the buffer size.
+     */
+    std::vector<char> buffer;
+    
+    /**
+     * Number of bytes waiting in \c buffer.
+     */
+    std::size_t used = 0;
+    
+    /**
+     * Number of bytes written to \c fd.
+     */
+    std::uint64_t bytes_written = 0;
+    
+    /**
+     * \c errno of the first failure, or zero.
+     */
+    int error = 0;
+};
+
+#endif	/* FDFORMATTARGET_H */
+
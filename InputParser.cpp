@@ -11,7 +11,8 @@
 XERCES_CPP_NAMESPACE_USE
 using namespace std;
 
-InputParser::InputParser()
+InputParser::InputParser(std::ostream& out) : 
+        grammar(CommandGrammar::Instance()), out(out)
 {
     Initialize();
 }
@@ -22,7 +23,7 @@ void InputParser::Run()
     
     do
     {
-        cout << "\nYour command: ";
+        out << "\nYour command: ";
         getline(cin, strUserEntry);
         
         // Throw exception if input loop is interrupted by stream failure
@@ -34,45 +35,201 @@ void InputParser::Run()
 void InputParser::Run(std::istream& exec)
 {
     string execLine;
+    bool quit = false;
+    
+    const auto start = chrono::steady_clock::now();
+    commands_run = 0;
+    commands_failed = 0;
 
-    while (getline(exec, execLine))
+    while (!quit && getline(exec, execLine))
     {
         // Skip empty lines
         if (execLine.size() > 1)
         {
             // output line to console then parse it
             // A quit command from the autoexec will halt the program
-            cout << "\nAutoexec: " << execLine << endl;
-            if (!ParseCommand(execLine)) { return; }
+            Message() << "\nAutoexec: " << execLine << endl;
+            quit = !ParseCommand(execLine);
         }
     }
     
-    // Go to user input loop after processing all commands from file
-    Run();
+    // Errors are all that was printed, so say how the script went
+    if (verbosity == Verbosity::Quiet)
+    {
+        OutputSummary(chrono::duration<double>(
+                chrono::steady_clock::now() - start).count());
+    }
+    
+    if (quit) { return; }
+    
+    // Go to user input loop after processing all commands from file, unless
+    //      running unattended
+    if (!batch_mode)
+    {
+        Run();
+    }
+    
+    else
+    {
+        WaitForJobs();
+    }
 }
 
-void InputParser::Run(const std::string& exec_filename)
+bool InputParser::Run(const std::string& exec_filename)
 {
     // Open input file for reading only
     ifstream fin(exec_filename.c_str(), ios::in);
     
-    cout << endl;
+    Message() << endl;
     
     if (fin) // Stream was opened successfully
     {
-        cout << "Autoexec successfully loaded from file: " 
+        Message() << "Autoexec successfully loaded from file: " 
                 << exec_filename << endl;
         
         Run(fin);
+        return true;
     }
     
     else // There was a problem opening the stream
     {
-        cout << "Error: Failed to load autoexec from file: "
+        out << "Error: Failed to load autoexec from file: "
                 << exec_filename << endl;
         
-        Run();
+        // There is no one to hand control to in batch mode
+        if (!batch_mode)
+        {
+            Run();
+        }
+        
+        return false;
+    }
+}
+
+void InputParser::SetBatchMode(const bool batch)
+{
+    batch_mode = batch;
+    auto_confirm = batch;
+    
+    // Nobody is around to answer a menu, so fall back to the documented
+    //      behavior of using the first match
+    if (batch && selection_policy == DOMUtil::SelectionPolicy::Prompt)
+    {
+        selection_policy = DOMUtil::SelectionPolicy::First;
+    }
+}
+
+void InputParser::SetSelectionPolicy(const DOMUtil::SelectionPolicy policy)
+{
+    selection_policy = policy;
+}
+
+void InputParser::SetVerbosity(const Verbosity level)
+{
+    verbosity = level;
+}
+
+bool InputParser::ParseVerbosity(const std::string& name, Verbosity& level)
+{
+    static const struct
+    {
+        const char* name;
+        Verbosity level;
+    }
+    levels[] =
+    {
+        { "quiet",  Verbosity::Quiet  },
+        { "normal", Verbosity::Normal }
+    };
+    
+    for (const auto& entry : levels)
+    {
+        if (jmhUtilities::caseInsCompare(name, entry.name))
+        {
+            level = entry.level;
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+bool InputParser::Load(const std::string& filename, 
+        const DocumentLoader::Options& options)
+{
+    DocumentLoader::Stats stats;
+    DOMDocument* loaded = nullptr;
+    
+    try
+    {
+        loaded = DocumentLoader::Load(filename, options, stats);
+    }
+    
+    // Keep the current document if the new one can't be parsed
+    catch (const std::runtime_error& err)
+    {
+        Error() << "Error: Failed to load the document from file: \"" 
+                << filename << "\"" << endl << err.what() << endl;
+        return false;
+    }
+    
+    // Release the old document, then index the new one from scratch
+    doc.reset(loaded);
+    index.Rebuild(doc->getDocumentElement());
+    
+    // Nothing in the current document's arena is in use any more
+    arena->Reset();
+    
+    Message() << "The document was successfully loaded from the file: \""
+            << filename << "\" (" << DescribeParse(stats) << ")." << endl;
+    return true;
+}
+
+std::string InputParser::DescribeParse(const DocumentLoader::Stats& stats)
+{
+    return (stats.mapped ? "memory-mapped, " : "streamed, ") + 
+            DescribeTransfer(stats.bytes, stats.seconds);
+}
+
+std::string InputParser::DescribeTransfer(const std::uint64_t bytes, 
+        const double seconds)
+{
+    // Format the measurements separately, so that out's flags are untouched
+    ostringstream measurements;
+    
+    // The size of a pipe isn't known, so neither is its throughput
+    if (bytes > 0)
+    {
+        measurements << bytes << " bytes in ";
     }
+    
+    measurements << fixed << setprecision(3) << seconds * 1000.0 << " ms";
+    
+    if (bytes > 0 && seconds > 0.0)
+    {
+        const double megabytes = bytes / (1024.0 * 1024.0);
+        measurements << ", " << setprecision(1) << megabytes / seconds 
+                << " MB/s";
+    }
+    
+    return measurements.str();
+}
+
+bool InputParser::ParseThreadCount(const std::string& text,
+        std::size_t& threads)
+{
+    char* endptr = nullptr;
+    errno = 0;
+    const unsigned long count = strtoul(text.c_str(), &endptr, 10);
+    
+    if (text.empty() || text[0] == '-' || count == 0 || count > 256 || 
+            errno == ERANGE || *endptr != 0)
+    {
+        return false;
+    }
+    
+    threads = count;
+    return true;
 }
 
 /////////////////////////////////
@@ -91,415 +248,1602 @@ void InputParser::Initialize()
     }
         
     // Create DOM document with pre-assigned root node
-    doc.reset(impl->createDocument(0, XSTR("Assignment7"), 0));
+    doc = CreateDocument(*arena, "Assignment7");
+    
+    // Index starts out holding only the root
+    index.Rebuild(doc->getDocumentElement());
+}
+
+DocumentPtr InputParser::CreateDocument(ArenaMemoryManager& document_arena, 
+        const std::string& root)
+{
+    // The document's nodes are allocated from its arena
+    DocumentPtr created(impl->createDocument(0, XSTR(root), 0, 
+            &document_arena));
     
-    if (!doc)
+    if (!created)
     {
-        // Throw an exception if the factory method for \c doc returns null. 
-        //      InputParser cannot be constructed in valid state if doc is
-        //      not constructed
+        // Throw an exception if the factory method for the document returns
+        //      null. InputParser cannot be constructed in valid state if doc
+        //      is not constructed
         throw std::runtime_error("An unspecified error occurred creating the document.");
     }
+    
+    return created;
+}
+
+void InputParser::SwapDocument(WorkspaceDocument& other)
+{
+    swap(arena, other.arena);
+    swap(doc, other.doc);
+    swap(index, other.index);
 }
 
 bool InputParser::ParseCommand(const std::string& strUserEntry)
 {
-    // Regex identifying a quit command. "Exit" is also accepted as a keyword
-    regex reQuit("^\\s*(quit|exit)\\s*$", regex::icase);
+    // Split the line into tokens once; every handler works from these
+    CommandGrammar::TokenList tokens;
+    CommandGrammar::Tokenize(strUserEntry, tokens);
     
-    // if the user didn't enter 'quit', parse the command string
-    //      and return true
-    if (!regex_match(strUserEntry, reQuit))
+    // Return false if it's time to quit. "Exit" is also accepted as a keyword
+    if (tokens.size() == 1 && 
+            grammar.Lookup(tokens[0]) == CommandGrammar::Keyword::Quit)
     {
-        ParseCommandString(jmhUtilities::trim(strUserEntry));
-        return true;
+        // Don't cut short any write still in progress
+        WaitForJobs();
+        return false;
     }
     
-    // Return false if it's time to quit
-    return false;
+    // If the user didn't enter 'quit', dispatch the command and return true
+    command_failed = false;
+    DispatchCommand(tokens);
+    
+    ++ commands_run;
+    if (command_failed) { ++ commands_failed; }
+    
+    return true;
 }
 
-void InputParser::ParseCommandString(const std::string& strUserEntry)
+void InputParser::DispatchCommand(const CommandGrammar::TokenList& tokens)
 {    
-    cmatch what;
+    typedef CommandGrammar::Keyword Keyword;
+    
+    // Handler for each basic command, keyed by the command's first token
+    static const struct
+    {
+        Keyword keyword;
+        CommandHandler handler;
+    }
+    dispatch_table[] =
+    {
+        { Keyword::Add,       &InputParser::ProcessAddCommand       },
+        { Keyword::Print,     &InputParser::ProcessPrintCommand     },
+        { Keyword::Write,     &InputParser::ProcessWriteCommand     },
+        { Keyword::Help,      &InputParser::ProcessHelpCommand      },
+        { Keyword::Delete,    &InputParser::ProcessDeleteCommand    },
+        { Keyword::Lookup,    &InputParser::ProcessLookupCommand    },
+        { Keyword::Load,      &InputParser::ProcessLoadCommand      },
+        { Keyword::Stream,    &InputParser::ProcessStreamCommand    },
+        { Keyword::Bench,     &InputParser::ProcessBenchCommand     },
+        { Keyword::Cache,     &InputParser::ProcessCacheCommand     },
+        { Keyword::Memory,    &InputParser::ProcessMemoryCommand    },
+        { Keyword::Jobs,      &InputParser::ProcessJobsCommand      },
+        { Keyword::Wait,      &InputParser::ProcessWaitCommand      },
+        { Keyword::Verbosity, &InputParser::ProcessVerbosityCommand },
+        { Keyword::Stats,     &InputParser::ProcessStatsCommand     },
+        { Keyword::New,       &InputParser::ProcessNewCommand       },
+        { Keyword::Use,       &InputParser::ProcessUseCommand       },
+        { Keyword::Close,     &InputParser::ProcessCloseCommand     },
+        { Keyword::Docs,      &InputParser::ProcessDocsCommand      }
+    };
+    
+    if (!tokens.empty())
+    {
+        // None of the cached names are in use between commands
+        names.Trim();
+        
+        const Keyword keyword = grammar.Lookup(tokens[0]);
+        
+        for (const auto& entry : dispatch_table)
+        {
+            if (entry.keyword == keyword)
+            {
+                ScopedTimer timer(command_stats.ForCommand(keyword));
+                (this->*entry.handler)(tokens);
+                return;
+            }
+        }
+    }
     
-    //regular expressions for basic commands
-    regex reBasicAddCommand("\\s*add($|(\\s+.*))", regex::icase);
-    regex reBasicPrintCommand("\\s*print($|(\\s+.*))", regex::icase);
-    regex reBasicWriteCommand("\\s*write($|(\\s+.*))", regex::icase);
-    regex reBasicHelpCommand("\\s*help\\s*", regex::icase);
-    regex reBasicDeleteCommand("\\s*del(ete)?($|(\\s+.*))", regex::icase);
+    OutputInvalidCommand();
+}
+
+void InputParser::OutputInvalidCommand()
+{
+    Error() << "Invalid command.  Acceptable commands are \"add\", \"print\", "
+            "\"write\", \"load\", \"stream\", \"delete\", \"help\", and "
+            "\"quit\"." << endl;
+}
+
+std::ostream& InputParser::Message()
+{
+    return (verbosity == Verbosity::Quiet) ? discard : out;
+}
+
+std::ostream& InputParser::Error()
+{
+    command_failed = true;
+    return out;
+}
+
+void InputParser::OutputSummary(const double seconds)
+{
+    out << "\nRan " << commands_run << " commands in " 
+            << DescribeTransfer(0, seconds) << ", " << commands_failed 
+            << " failed." << endl;
+}
+
+void InputParser::ProcessVerbosityCommand(
+        const CommandGrammar::TokenList& tokens)
+{
+    Verbosity level = verbosity;
     
-    // test for each basic command in turn
-    if (regex_match(strUserEntry, reBasicAddCommand))
+    // With no argument, report the current level
+    if (tokens.size() == 1)
     {
-        // Add
-        ProcessAddCommand(strUserEntry);
+        out << "Commands currently report " << ((verbosity == 
+                Verbosity::Quiet) ? "only errors." : "what they did.") << endl;
     }
     
-    else if (regex_match(strUserEntry, reBasicPrintCommand))
+    else if (tokens.size() == 2 && ParseVerbosity(tokens[1].str(), level))
     {
-        // Print
-        ProcessPrintCommand(strUserEntry);
+        verbosity = level;
+        
+        // Printed either way, so that it's clear the command worked
+        out << "Commands will report " << ((verbosity == Verbosity::Quiet) ? 
+                "only errors." : "what they did.") << endl;
     }
     
-    else if (regex_match(strUserEntry, reBasicWriteCommand))
+    else // Output error if command is invalid
+    {
+        Error() << "Invalid \"verbosity\" command. Valid signatures for "
+                "verbosity are:" << endl;
+        out << "> verbosity" << endl;
+        out << "> verbosity quiet" << endl;
+        out << "> verbosity normal" << endl;
+    }
+}
+
+void InputParser::OutputStats() const
+{
+    command_stats.Report(out);
+}
+
+std::size_t InputParser::CommandsRun() const
+{
+    return commands_run;
+}
+
+std::size_t InputParser::CommandsFailed() const
+{
+    return commands_failed;
+}
+
+void InputParser::ProcessStatsCommand(const CommandGrammar::TokenList& tokens)
+{
+    // With no argument, report on every command and operation
+    if (tokens.size() == 1)
     {
-        // Write to file
-        ProcessWriteCommand(strUserEntry);
+        OutputStats();
     }
     
-    else if (regex_match(strUserEntry, reBasicHelpCommand))
+    else if (tokens.size() == 2 && 
+            CommandGrammar::EqualsIgnoreCase(tokens[1], "clear"))
     {
-        // Help
-        ProcessHelpCommand();
+        command_stats.Clear();
+        Message() << "The command statistics were cleared." << endl;
     }
     
-    else if (regex_match(strUserEntry, reBasicDeleteCommand))
+    else if (tokens.size() == 2 && 
+            command_stats.ReportHistogram(tokens[1].str(), out))
     {
-        // Delete
-        ProcessDeleteCommand(strUserEntry);
+        // The histogram has been printed
     }
     
-    else
+    else // Output error if command is invalid
     {
-        cout << "Invalid command.  Acceptable commands are \"add\", \"print\", "
-                "\"write\", \"delete\", \"help\", and \"quit\"." << endl;
+        Error() << "Invalid \"stats\" command. Valid signatures for stats "
+                "are:" << endl;
+        out << "> stats" << endl;
+        out << "> stats clear" << endl;
+        out << "> stats [command name|+lookup|+append|+remove|+serialize]" 
+                << endl;
     }
 }
 
-void InputParser::ProcessAddCommand(const std::string& strUserEntry)
+void InputParser::ProcessAddCommand(const CommandGrammar::TokenList& tokens)
 {
-    // regular expressions for the second parameter in the add command
-    regex reAddElementCommand("\\s*add\\s+element($|(\\s.*))", regex::icase);
-    regex reAddAttributeCommand("\\s*add\\s+attribute($|(\\s.*))", regex::icase);
-
+    typedef CommandGrammar::Keyword Keyword;
+    
+    // Identify the second parameter of the add command, if there is one
+    const Keyword second = (tokens.size() > 1) ? 
+            grammar.Lookup(tokens[1]) : Keyword::Unknown;
+    
     // test for each possible second parameter in turn
-    if (regex_match(strUserEntry, reAddElementCommand))
+    if (second == Keyword::Element)
+    {
+        ProcessAddElementCommand(tokens);
+    }
+    
+    else if (second == Keyword::Attribute)
+    {
+        ProcessAddAttributeCommand(tokens);
+    }
+    
+    else if (second == Keyword::Elements)
     {
-        ProcessAddElementCommand(strUserEntry);
+        ProcessAddElementsCommand(tokens);
     }
     
-    else if (regex_match(strUserEntry, reAddAttributeCommand))
+    else if (second == Keyword::Attributes)
     {
-        ProcessAddAttributeCommand(strUserEntry);
+        ProcessAddAttributesCommand(tokens);
     }
     
     else // Output error if command is invalid
     {
-        cout << "Invalid \"add\" command: 2nd parameter must be \"element\" "
-                "or \"attribute\"." << endl;
-        cout << "Valid signatures for add are:" << endl;
-        cout << "> add element [parent name] [child name]" << endl;
-        cout << "> add element [parent name] [child name] "
+        Error() << "Invalid \"add\" command: 2nd parameter must be "
+                "\"element\", \"attribute\", \"elements\" or \"attributes\"."
+                << endl;
+        out << "Valid signatures for add are:" << endl;
+        out << "> add element [parent name] [child name]" << endl;
+        out << "> add element [parent name] [child name] "
                 "[child content]" << endl;
-        cout << "> add attribute [parent name] [key] [value]" << endl;
+        out << "> add attribute [parent name] [key] [value]" << endl;
+        out << "> add elements [parent name] [child name] "
+                "[count|content,content,...]" << endl;
+        out << "> add attributes [parent name] [key] [value] "
+                "<[key] [value]...>" << endl;
     }
 }
 
-void InputParser::ProcessAddElementCommand(const std::string& strUserEntry)
+void InputParser::ProcessAddElementCommand(
+        const CommandGrammar::TokenList& tokens)
 {
-    // the what variable is actually an array that will be populated by the 
-    //      regex_match function when matched groups are found
-    cmatch what;
-    // what[0] contains the entire matched string
-    // what[1] contains the first matched group
-    // what[2] contains the second matched group
-    // what[3] etc.
-
-    // regular expression to pick out the name of the parent to which the new 
-    //      element is to be added and the name of the new element itself
-    regex reAddElementCmd(
-            "^\\s*add\\s*element\\s*(\\w+)\\s*(\\w+)(\\s*((\\w|\\d)+))?\\s*$", 
-            regex::icase);
-
-    // note that the following variant of the regex_match command requires 
-    //      a C string, not an STL string
-    if (regex_match(strUserEntry.c_str(), what, reAddElementCmd))
+    // tokens[0] and tokens[1] are "add element"
+    // tokens[2] is the name of the parent to which the new element is added
+    // tokens[3] is the name of the new element itself
+    // tokens[4] is the optional content of the new element
+    const size_t argc = tokens.size();
+    
+    if ((argc == 4 || argc == 5) && 
+            CommandGrammar::IsAddress(tokens[2]) && 
+            CommandGrammar::IsWord(tokens[3]) &&
+            (argc == 4 || CommandGrammar::IsWord(tokens[4])))
     {        
-        AddElement(what[1], what[2], what[4]);
+        AddElement(tokens[2].str(), tokens[3].str(), 
+                (argc == 5) ? tokens[4].str() : string());
     }
     
     else // Output error if command is invalid
     {        
-        cout << "Invalid \"add element\" command. Valid signatures for "
+        Error() << "Invalid \"add element\" command. Valid signatures for "
                 "add element are:" << endl;
-        cout << "> add element [parent name] [child name]" << endl;
-        cout << "> add element [parent name] [child name] "
+        out << "> add element [parent name] [child name]" << endl;
+        out << "> add element [parent name] [child name] "
                 "[child content]" << endl;
     }
 }
 
-void InputParser::ProcessAddAttributeCommand(const std::string& strUserEntry)
+void InputParser::ProcessAddAttributeCommand(
+        const CommandGrammar::TokenList& tokens)
 {
-    // the what variable is actually an array that will be populated by the 
-    //    regex_match function when matched groups are found
-    cmatch what;
-    // what[0] contains the entire matched string
-    // what[1] contains the first matched group
-    // what[2] contains the second matched group
-    // what[3] etc.
-
-    // regular expression to pick out the name of the element to which the 
-    //     new attribute is to be added, the name of the new attribute, and the 
-    //     value of that attribute
-    regex reAddAttributeCmd(
-            "^\\s*add\\s*attribute\\s*(\\w+)\\s*(\\w+)\\s*(\\w+)\\s*$", 
-            regex::icase);
-
-    // note that the following variant of the regex_match command requires 
-    //      a C string, not an STL string
-    if (regex_match(strUserEntry.c_str(), what, reAddAttributeCmd))
+    // tokens[0] and tokens[1] are "add attribute"
+    // tokens[2] is the name of the element to which the attribute is added
+    // tokens[3] is the name of the new attribute
+    // tokens[4] is the value of that attribute
+    if (tokens.size() == 5 && 
+            CommandGrammar::IsAddress(tokens[2]) && 
+            CommandGrammar::IsWord(tokens[3]) && 
+            CommandGrammar::IsWord(tokens[4]))
     {
-        AddAttribute(what[1], what[2], what[3]);
+        AddAttribute(tokens[2].str(), tokens[3].str(), tokens[4].str());
     }
     
     else // Output error if command is invalid
     {        
-        cout << "Invalid \"add attribute\" command. Valid signature for "
+        Error() << "Invalid \"add attribute\" command. Valid signature for "
                 "add attribute is:" << endl;
-        cout << "> add attribute [parent name] [key] [value]" << endl;
+        out << "> add attribute [parent name] [key] [value]" << endl;
     }
 }
 
-void InputParser::ProcessDeleteCommand(const std::string& strUserEntry)
+void InputParser::ProcessAddElementsCommand(
+        const CommandGrammar::TokenList& tokens)
 {
-    // Regex for a valid delete command requires exactly one argument
-    regex reFullDeleteCommand("^\\s*del(ete)?\\s+(\\w+)\\s*$");
-    cmatch what;
+    // tokens[0] and tokens[1] are "add elements"
+    // tokens[2] is the name of the parent to which the new elements are added
+    // tokens[3] is the name of the new elements
+    // tokens[4] is either the number of elements to add, or a comma-separated
+    //      list of their contents
+    bool valid = tokens.size() == 5 && 
+            CommandGrammar::IsAddress(tokens[2]) && 
+            CommandGrammar::IsWord(tokens[3]);
     
-    if (regex_match(strUserEntry.c_str(), what, reFullDeleteCommand))
-    {
-        DeleteElement(what[2]);
-    }
+    unsigned long count = 0;
+    vector<string> contents;
     
-    else // Output error if command is invalid
+    if (valid)
     {
-        cout << "Invalid \"delete\" command. Valid signature for delete is:" << endl;
-        cout << "> delete [element name]" << endl;
-    }
-}
-
-void InputParser::ProcessPrintCommand(const std::string& strUserEntry)
-{    
-    // Print command requires either zero or one argument, with certain
-    //      non-word characters allowed for the second argument (characters
-    //      commonly used in file names).
-    regex rePrintFullCommand("^\\s*print(\\s+(\\w+))?\\s*$", regex::icase);
-    cmatch what;
-    
-    // If match is found, then it is a valid command
-    if (regex_match(strUserEntry.c_str(), what, rePrintFullCommand))
-    {        
-        // what[2] is the match for the optional element name.
-        if (what[2].str().empty())
+        const string last = tokens[4].str();
+        
+        // Anything that isn't a number is a list of contents
+        if (last.find_first_not_of("0123456789") != string::npos)
         {
-            OutputDocument();
+            jmhUtilities::StringSplit(last, ',', contents);
+            valid = !contents.empty();
+            
+            for (const string& content : contents)
+            {
+                valid = valid && CommandGrammar::IsWord(CommandGrammar::Token{
+                        content.data(), content.size() });
+            }
         }
         
         else
         {
-            PrintSubTree(what[2]);
-        }             
+            errno = 0;
+            count = strtoul(last.c_str(), nullptr, 10);
+            valid = (count != 0 && errno != ERANGE);
+        }
     }
     
-    // Else print helper message for 'print' syntax
-    else
+    if (valid)
     {
-        cout << "Invalid print command. The optional parameter specifies "
-                "the node to treat as the root of the output." << endl;
-        cout << "Valid signatures for print are:" <<  endl;
-        cout << "> print" << endl;
-        cout << "> print [root name]" << endl;
+        AddElements(tokens[2].str(), tokens[3].str(), count, contents);
+    }
+    
+    else // Output error if command is invalid
+    {
+        Error() << "Invalid \"add elements\" command. Valid signatures for "
+                "add elements are:" << endl;
+        out << "> add elements [parent name] [child name] [count]" << endl;
+        out << "> add elements [parent name] [child name] "
+                "[content,content,...]" << endl;
     }
 }
 
-void InputParser::ProcessWriteCommand(const std::string& strUserEntry)
+void InputParser::ProcessAddAttributesCommand(
+        const CommandGrammar::TokenList& tokens)
 {
-    // Full command for write. Allows periods and underscores in addition to
-    //      word characters for file names.
-    regex reWriteFullCommand("^\\s*write\\s+((\\w|\\.|_)+)\\s*$");
-    cmatch what;
+    // tokens[0] and tokens[1] are "add attributes"
+    // tokens[2] is the name of the element to which the attributes are added
+    // tokens[3...] are pairs of attribute names and values
+    const size_t argc = tokens.size();
+    bool valid = argc >= 5 && argc <= CommandGrammar::MAX_TOKENS && 
+            (argc - 3) % 2 == 0 && CommandGrammar::IsAddress(tokens[2]);
     
-    if (regex_match(strUserEntry.c_str(), what, reWriteFullCommand))
+    vector<pair<string, string>> attributes;
+    
+    for (size_t i = 3; valid && i < argc; i += 2)
     {
-        WriteToFile(what[1]);
+        valid = CommandGrammar::IsWord(tokens[i]) && 
+                CommandGrammar::IsWord(tokens[i + 1]);
+        attributes.emplace_back(tokens[i].str(), tokens[i + 1].str());
     }
     
-    else
+    if (valid)
     {
-        cout << "Invalid Write Command. Valid signature for write is:" << endl;
-        cout << "> write [file path]" << endl;
-        
+        AddAttributes(tokens[2].str(), attributes);
+    }
+    
+    else // Output error if command is invalid
+    {
+        Error() << "Invalid \"add attributes\" command. Valid signature for "
+                "add attributes is:" << endl;
+        out << "> add attributes [parent name] [key] [value] "
+                "<[key] [value]...>" << endl;
     }
 }
 
-void InputParser::OutputDocument()
+void InputParser::ProcessDeleteCommand(const CommandGrammar::TokenList& tokens)
 {
-    using namespace std;
-    
-    // Get root from document
-    DOMElement* root = doc->getDocumentElement();
-    
-    // Create tree walker that will visit all nodes
-    TreeWalkerPtr walker(doc->createTreeWalker(
-            root, DOMNodeFilter::SHOW_ALL, nullptr, true));
-    
-    // Initial call to nextNode() as required by the documentation
-    DOMNode* node = walker->nextNode();
-    
-    // Check for empty tree before proceeding
-    if (!node)
+    // A valid delete command requires exactly one argument
+    if (tokens.size() == 2 && CommandGrammar::IsAddress(tokens[1]))
     {
-        cout << "Document is empty." << endl;
-        return;
+        DeleteElement(tokens[1].str());
     }
     
-    // While there are still nodes...
-    while (node != nullptr)
+    else // Output error if command is invalid
     {
-        // Each sibling is treated as a node and passed to the recursive
-        //      helper function
-        DOMUtil::OutputDocSubTree(0, node);
-        node = walker->nextSibling();
+        Error() << "Invalid \"delete\" command. Valid signature for delete "
+                "is:" << endl;
+        out << "> delete [element name]" << endl;
     }
 }
 
-void InputParser::AddElement(const std::string& parent_name, 
-        const std::string& child_name, const std::string& child_content)
-{
-    // Special syntax used to specify the root. As a side-effect, elements with
-    //      the name "root" are not supported.
-    regex rootElementSpecifier("^\\s*root\\s*$", regex::icase);
-    
-    // Root node of the current document
-    DOMNode* root = doc->getDocumentElement();
-    
-    // Node being appended to. Initialized to null to indicate that 
-    //      there is no default parent
-    DOMNode* parent = nullptr;
+void InputParser::ProcessPrintCommand(const CommandGrammar::TokenList& tokens)
+{    
+    // Print command requires either zero or one argument
+    if (tokens.size() == 1)
+    {        
+        OutputDocument();
+    }
     
-    // If user specified root, set parent to root
-    if (regex_match(parent_name.c_str(), rootElementSpecifier))
+    else if (tokens.size() == 2 && CommandGrammar::IsAddress(tokens[1]))
     {
-        parent = root;
+        PrintSubTree(tokens[1].str());
     }
-
-    // Else search the tree for elements matching the specified name
+    
+    // Else print helper message for 'print' syntax
     else
-    {        
-        DOMNodeList* elements = doc->getElementsByTagName(XSTR(parent_name));
-        
-        parent = DOMUtil::SelectNodeFromList(elements);
+    {
+        Error() << "Invalid print command. The optional parameter specifies "
+                "the node to treat as the root of the output." << endl;
+        out << "Valid signatures for print are:" <<  endl;
+        out << "> print" << endl;
+        out << "> print [root name]" << endl;
     }
+}
+
+void InputParser::ProcessWriteCommand(const CommandGrammar::TokenList& tokens)
+{
+    // tokens[1] is the destination. Allows periods and underscores in
+    //      addition to word characters for file names, and also accepts "-"
+    //      for standard out and "fd:N" for an open file descriptor.
+    // tokens[2...] are options
+    const size_t argc = tokens.size();
+    bool valid = (argc >= 2 && argc <= 7) && 
+            (CommandGrammar::IsFileName(tokens[1]) || 
+            CommandGrammar::EqualsIgnoreCase(tokens[1], "-") ||
+            (tokens[1].length > 3 && 
+            CommandGrammar::EqualsIgnoreCase(
+                    CommandGrammar::Token{ tokens[1].text, 3 }, "fd:")));
     
-    // If parent points to valid node, create child and append it
-    if (parent)
+    DocumentWriter::Options options;
+    bool background = false;
+    const string buffer_option = "buffer=";
+    const string threads_option = "threads=";
+    
+    for (size_t i = 2; valid && i < argc; ++ i)
     {
-        // Create and append child
-        DOMElement* child = doc->createElement(XSTR(child_name));
-        parent->appendChild(child);
+        const string option = tokens[i].str();
         
-        cout << "Element \"" << child_name << "\" ";
+        if (CommandGrammar::EqualsIgnoreCase(tokens[i], "pretty"))
+        {
+            options.pretty = true;
+        }
         
-        // Only add content to child if there is content to add
-        if (!child_content.empty())
+        else if (CommandGrammar::EqualsIgnoreCase(tokens[i], "gzip"))
         {
-            //string trim_content = jmhUtilities::trim(child_content);
-            DOMText* child_text = doc->createTextNode(XSTR(child_content));
-            child->appendChild(child_text);
-            cout << "with content \"" << child_content << "\" ";
+            options.compression = DocumentWriter::Compression::Gzip;
+        }
+        
+        else if (CommandGrammar::EqualsIgnoreCase(tokens[i], "zstd"))
+        {
+            options.compression = DocumentWriter::Compression::Zstd;
+        }
+        
+        else if (CommandGrammar::EqualsIgnoreCase(tokens[i], "nocompress"))
+        {
+            options.compression = DocumentWriter::Compression::None;
+        }
+        
+        else if (CommandGrammar::EqualsIgnoreCase(tokens[i], "background"))
+        {
+            background = true;
+        }
+        
+        // Buffer size in kilobytes
+        else if (option.compare(0, buffer_option.size(), buffer_option) == 0)
+        {
+            const string size = option.substr(buffer_option.size());
+            char* endptr = nullptr;
+            errno = 0;
+            const unsigned long kilobytes = strtoul(size.c_str(), &endptr, 10);
+            
+            valid = (kilobytes != 0 && errno != ERANGE && *endptr == 0 && 
+                    kilobytes <= SIZE_MAX / 1024);
+            options.buffer_size = kilobytes * 1024;
+        }
+        
+        // Number of serializing threads
+        else if (option.compare(0, threads_option.size(), threads_option) 
+                == 0)
+        {
+            valid = ParseThreadCount(option.substr(threads_option.size()),
+                    options.threads);
         }
         
-        // If there is no content, reflect this in the output message
         else
         {
-            cout << "(with no content) ";
+            valid = false;
         }
-                
-        cout << "was successfully appended to parent Element \""
-                << LSTR(parent->getNodeName()) << "\"." << endl;
     }
     
-    // Print error message if parent can't be found
-    else
+    if (valid && background)
     {
-        cout << "No element with the name \"" << parent_name
-                << "\" could be found." << endl;
+        StartBackgroundWrite(tokens[1].str(), options);
     }
-}
-
-void InputParser::WriteToFile(const std::string& filename)
-{
-    // Get serializer from DOM implementation
-    LSSerializerPtr serializer(impl->createLSSerializer());
     
-    // Get output description from DOM implementation
-    LSOutputPtr output_desc(impl->createLSOutput());
-        
-    // Operation result defaults to false (in the case that 
-    //      serializer-write() is never called)
-    bool write_result = false;
+    else if (valid)
+    {
+        WriteToFile(tokens[1].str(), options);
+    }
     
-    // Only attempt to write to the file if the serializer and output 
-    //      description were successfully constructed.
-    if (serializer && output_desc)
+    else
     {
-        // Set serializer to output to the file specified
-        unique_ptr<XMLFormatTarget> format_target(
-                new LocalFileFormatTarget(filename.c_str()));
-
-        output_desc->setByteStream(format_target.get());
-        
-        // Write doc to output
-        write_result = serializer->write(doc.get(), output_desc.get());
+        Error() << "Invalid Write Command. Valid signature for write is:" 
+                << endl;
+        out << "> write [file path|-|fd:N] <pretty?> <buffer=KB?> "
+                "<threads=N?> <gzip|zstd|nocompress?> <background?>" << endl;
     }
-       
-    // Output whether serialization was successful or not    
-    cout << (write_result ? 
-            "The document was successfully written to the file: \"" :
-            "There was an error writing the document to the file: \"") 
-            << filename << "\"" << endl;
 }
 
-void InputParser::AddAttribute( const std::string& parent_name,
-        const std::string& attr_name, const std::string& attr_val)
+void InputParser::ProcessJobsCommand(const CommandGrammar::TokenList& tokens)
+{
+    // Jobs takes no arguments
+    if (tokens.size() != 1)
+    {
+        Error() << "Invalid \"jobs\" command. Valid signature for jobs is:" 
+                << endl;
+        out << "> jobs" << endl;
+        return;
+    }
+    
+    if (jobs.empty())
+    {
+        out << "There are no background writes." << endl;
+        return;
+    }
+    
+    const auto now = chrono::steady_clock::now();
+    
+    // Report the finished jobs and drop them; list the rest as running
+    for (auto job = jobs.begin(); job != jobs.end(); )
+    {
+        if (job->outcome.wait_for(chrono::seconds(0)) == 
+                future_status::ready)
+        {
+            FinishJob(*job);
+            job = jobs.erase(job);
+        }
+        
+        else
+        {
+            // Format separately, so that out's flags are untouched
+            ostringstream elapsed;
+            elapsed << fixed << setprecision(1) << chrono::duration<double>(
+                    now - job->started).count();
+            
+            out << "Job " << job->id << ": writing to the file: \"" 
+                    << job->filename << "\" (running for " << elapsed.str() 
+                    << " s)." << endl;
+            ++ job;
+        }
+    }
+}
+
+void InputParser::ProcessWaitCommand(const CommandGrammar::TokenList& tokens)
+{
+    // tokens[1] is the optional number of the job to wait for
+    const size_t argc = tokens.size();
+    unsigned long id = 0;
+    bool valid = (argc == 1 || argc == 2);
+    
+    if (argc == 2)
+    {
+        const string number = tokens[1].str();
+        char* endptr = nullptr;
+        errno = 0;
+        id = strtoul(number.c_str(), &endptr, 10);
+        
+        valid = (id != 0 && errno != ERANGE && *endptr == 0);
+    }
+    
+    if (!valid)
+    {
+        Error() << "Invalid \"wait\" command. Valid signatures for wait are:" 
+                << endl;
+        out << "> wait" << endl;
+        out << "> wait [job number]" << endl;
+        return;
+    }
+    
+    if (id == 0)
+    {
+        if (jobs.empty())
+        {
+            out << "There are no background writes." << endl;
+        }
+        
+        WaitForJobs();
+        return;
+    }
+    
+    for (auto job = jobs.begin(); job != jobs.end(); ++ job)
+    {
+        if (job->id == id)
+        {
+            FinishJob(*job);
+            jobs.erase(job);
+            return;
+        }
+    }
+    
+    Error() << "Error: There is no background write with the number " << id 
+            << "." << endl;
+}
+
+void InputParser::ProcessLookupCommand(const CommandGrammar::TokenList& tokens)
+{
+    // Threads for "parallel": one per core unless a number is given
+    size_t threads = max(thread::hardware_concurrency(), 1u);
+    const bool parallel = (tokens.size() == 2 || tokens.size() == 3) &&
+            CommandGrammar::EqualsIgnoreCase(tokens[1], "parallel") &&
+            (tokens.size() == 2 || ParseThreadCount(tokens[2].str(), threads));
+    
+    // With no argument, report the current lookup mode
+    if (tokens.size() == 1)
+    {
+        out << "Elements are currently found by ";
+        
+        if (use_index)
+        {
+            out << "index." << endl;
+        }
+        
+        else if (scan_threads > 1)
+        {
+            out << "scanning the document on " << scan_threads << " threads."
+                    << endl;
+        }
+        
+        else
+        {
+            out << "scanning the document." << endl;
+        }
+    }
+    
+    else if (tokens.size() == 2 && 
+            CommandGrammar::EqualsIgnoreCase(tokens[1], "index"))
+    {
+        use_index = true;
+        Message() << "Elements will be found using the name index." << endl;
+    }
+    
+    else if (tokens.size() == 2 && 
+            CommandGrammar::EqualsIgnoreCase(tokens[1], "scan"))
+    {
+        use_index = false;
+        scan_threads = 1;
+        Message() << "Elements will be found by scanning the document." << endl;
+    }
+    
+    else if (parallel)
+    {
+        use_index = false;
+        scan_threads = threads;
+        Message() << "Elements will be found by scanning the document on "
+                << threads << " threads." << endl;
+    }
+    
+    else // Output error if command is invalid
+    {
+        Error() << "Invalid \"lookup\" command. Valid signatures for lookup "
+                "are:" << endl;
+        out << "> lookup" << endl;
+        out << "> lookup index" << endl;
+        out << "> lookup scan" << endl;
+        out << "> lookup parallel <threads?>" << endl;
+    }
+}
+
+void InputParser::ProcessLoadCommand(const CommandGrammar::TokenList& tokens)
+{
+    // tokens[1] is the path of the file; any token is accepted, since paths
+    //      may contain separators. Parser options may follow it.
+    bool valid = (tokens.size() >= 2 && tokens.size() <= 5);
+    DocumentLoader::Options options;
+    
+    for (size_t i = 2; valid && i < tokens.size(); ++ i)
+    {
+        if (CommandGrammar::EqualsIgnoreCase(tokens[i], "novalidate"))
+        {
+            options.validate = false;
+        }
+        
+        else if (CommandGrammar::EqualsIgnoreCase(tokens[i], "nonamespaces"))
+        {
+            options.namespaces = false;
+        }
+        
+        else if (CommandGrammar::EqualsIgnoreCase(tokens[i], "nommap"))
+        {
+            options.memory_map = false;
+        }
+        
+        else
+        {
+            valid = false;
+        }
+    }
+    
+    if (valid)
+    {
+        Load(tokens[1].str(), options);
+    }
+    
+    else // Output error if command is invalid
+    {
+        Error() << "Invalid \"load\" command. Valid signature for load is:" 
+                << endl;
+        out << "> load [file path] <novalidate?> <nonamespaces?> <nommap?>" 
+                << endl;
+    }
+}
+
+void InputParser::ProcessStreamCommand(
+        const CommandGrammar::TokenList& tokens)
+{
+    // tokens[1] is "print" or "count"
+    // tokens[2] is the path of the file; any token is accepted
+    // tokens[3] is the optional name of the elements to print or count
+    const size_t argc = tokens.size();
+    const bool valid = (argc == 3 || argc == 4) && 
+            (argc == 3 || CommandGrammar::IsWord(tokens[3]));
+    
+    if (valid && CommandGrammar::EqualsIgnoreCase(tokens[1], "print"))
+    {
+        StreamFile(tokens[2].str(), (argc == 4) ? tokens[3].str() : string(), 
+                true);
+    }
+    
+    else if (valid && CommandGrammar::EqualsIgnoreCase(tokens[1], "count"))
+    {
+        StreamFile(tokens[2].str(), (argc == 4) ? tokens[3].str() : string(), 
+                false);
+    }
+    
+    else // Output error if command is invalid
+    {
+        Error() << "Invalid \"stream\" command. Valid signatures for stream "
+                "are:" << endl;
+        out << "> stream print [file path] <element name?>" << endl;
+        out << "> stream count [file path] <element name?>" << endl;
+    }
+}
+
+void InputParser::ProcessBenchCommand(const CommandGrammar::TokenList& tokens)
+{
+    // tokens[1] names the benchmark
+    // tokens[2] is the optional size of the benchmark
+    const bool transcode = tokens.size() >= 2 && 
+            CommandGrammar::EqualsIgnoreCase(tokens[1], "transcode");
+    const bool strings = tokens.size() >= 2 && 
+            CommandGrammar::EqualsIgnoreCase(tokens[1], "strings");
+    
+    // Iterations for "transcode", line length for "strings"
+    size_t size = transcode ? 1000000 : 1 << 20;
+    bool valid = (tokens.size() == 2 || tokens.size() == 3) && 
+            (transcode || strings);
+    
+    if (valid && tokens.size() == 3)
+    {
+        const string count = tokens[2].str();
+        char* endptr = nullptr;
+        errno = 0;
+        size = strtoul(count.c_str(), &endptr, 10);
+        
+        valid = (size != 0 && errno != ERANGE && *endptr == 0);
+    }
+    
+    if (!valid) // Output error if command is invalid
+    {
+        Error() << "Invalid \"bench\" command. Valid signatures for bench are:" 
+                << endl;
+        out << "> bench transcode <iterations?>" << endl;
+        out << "> bench strings <line length?>" << endl;
+        return;
+    }
+    
+    // Process about 64 MB of text in the strings benchmark, whatever the
+    //      length of the line
+    const vector<Benchmark::Result> results = transcode ? 
+            Benchmark::Transcode(size) : 
+            Benchmark::Strings(size, max<size_t>(1, (64 << 20) / size));
+    
+    for (const Benchmark::Result& result : results)
+    {
+        // Format separately, so that out's flags are untouched
+        ostringstream line;
+        line << result.name << ": " << result.operations << " in " 
+                << fixed << setprecision(3) << result.seconds * 1000.0 
+                << " ms, " << setprecision(0) << result.PerSecond() 
+                << " per second";
+        
+        out << line.str() << endl;
+    }
+}
+
+void InputParser::ProcessCacheCommand(const CommandGrammar::TokenList& tokens)
+{
+    // With no argument, report on the caches
+    if (tokens.size() == 1)
+    {
+        const uint64_t lookups = names.Hits() + names.Misses();
+        
+        out << "Name cache: " << names.Size() << " names, " << names.Hits()
+                << " hits, " << names.Misses() << " misses";
+        
+        if (lookups > 0)
+        {
+            out << " (" << (100 * names.Hits() / lookups) << "% hit rate)";
+        }
+        
+        out << "." << endl;
+        
+        const uint64_t queries = paths.Hits() + paths.Misses();
+        
+        out << "Path cache: " << paths.Size() << " paths, " << paths.Hits()
+                << " hits, " << paths.Misses() << " misses";
+        
+        if (queries > 0)
+        {
+            out << " (" << (100 * paths.Hits() / queries) << "% hit rate)";
+        }
+        
+        out << "." << endl;
+    }
+    
+    else if (tokens.size() == 2 && 
+            CommandGrammar::EqualsIgnoreCase(tokens[1], "clear"))
+    {
+        names.Clear();
+        paths.Clear();
+        Message() << "The name and path caches were cleared." << endl;
+    }
+    
+    else // Output error if command is invalid
+    {
+        Error() << "Invalid \"cache\" command. Valid signatures for cache "
+                "are:" << endl;
+        out << "> cache" << endl;
+        out << "> cache clear" << endl;
+    }
+}
+
+void InputParser::ProcessMemoryCommand(const CommandGrammar::TokenList& tokens)
+{
+    // Memory takes no arguments
+    if (tokens.size() != 1)
+    {
+        Error() << "Invalid \"memory\" command. Valid signature for memory is:"
+                << endl;
+        out << "> memory" << endl;
+        return;
+    }
+    
+    const ArenaMemoryManager::Usage usage = arena->GetUsage();
+    
+    out << "Arena of \"" << document_name << "\": " << usage.bytes_used 
+            << " bytes used of " << usage.bytes_reserved << " reserved in " 
+            << usage.blocks << " blocks (" << usage.allocations 
+            << " allocations, " << usage.deallocations << " deallocations)." 
+            << endl;
+}
+
+void InputParser::ProcessNewCommand(const CommandGrammar::TokenList& tokens)
+{
+    // tokens[1] is the name of the new document
+    // tokens[2] is the optional name of its root element
+    const size_t argc = tokens.size();
+    
+    if ((argc != 2 && argc != 3) || !CommandGrammar::IsWord(tokens[1]) ||
+            (argc == 3 && !CommandGrammar::IsWord(tokens[2])))
+    {
+        Error() << "Invalid \"new\" command. Valid signatures for new are:"
+                << endl;
+        out << "> new [document name]" << endl;
+        out << "> new [document name] [root name]" << endl;
+        return;
+    }
+    
+    const string name = tokens[1].str();
+    
+    if (name == document_name || documents.count(name) > 0)
+    {
+        Error() << "Error: There is already a document named \"" << name 
+                << "\"." << endl;
+        return;
+    }
+    
+    // Build the document before touching the workspace, in case it fails
+    WorkspaceDocument created;
+    created.arena.reset(new ArenaMemoryManager());
+    created.doc = CreateDocument(*created.arena, 
+            (argc == 3) ? tokens[2].str() : string("Assignment7"));
+    created.index.Rebuild(created.doc->getDocumentElement());
+    
+    // Set the current document aside, and make the new one current
+    SwapDocument(created);
+    documents.emplace(document_name, std::move(created));
+    document_name = name;
+    
+    Message() << "Created the document \"" << name << "\", which is now "
+            "current." << endl;
+}
+
+void InputParser::ProcessUseCommand(const CommandGrammar::TokenList& tokens)
+{
+    if (tokens.size() != 2 || !CommandGrammar::IsWord(tokens[1]))
+    {
+        Error() << "Invalid \"use\" command. Valid signature for use is:" 
+                << endl;
+        out << "> use [document name]" << endl;
+        return;
+    }
+    
+    const string name = tokens[1].str();
+    
+    if (name == document_name)
+    {
+        Message() << "The document \"" << name << "\" is already current." 
+                << endl;
+        return;
+    }
+    
+    auto entry = documents.find(name);
+    
+    if (entry == documents.end())
+    {
+        Error() << "Error: There is no document named \"" << name << "\"." 
+                << endl;
+        return;
+    }
+    
+    // Take the document out of the workspace, and put the current one back
+    //      in its place under its own name
+    WorkspaceDocument target = std::move(entry->second);
+    documents.erase(entry);
+    
+    SwapDocument(target);
+    documents.emplace(document_name, std::move(target));
+    document_name = name;
+    
+    Message() << "Now using the document \"" << name << "\"." << endl;
+}
+
+void InputParser::ProcessCloseCommand(const CommandGrammar::TokenList& tokens)
+{
+    // tokens[1] is the optional name of the document; the current one by
+    //      default
+    if (tokens.size() > 2 || 
+            (tokens.size() == 2 && !CommandGrammar::IsWord(tokens[1])))
+    {
+        Error() << "Invalid \"close\" command. Valid signatures for close "
+                "are:" << endl;
+        out << "> close" << endl;
+        out << "> close [document name]" << endl;
+        return;
+    }
+    
+    const string name = (tokens.size() == 2) ? tokens[1].str() : document_name;
+    
+    if (name != document_name)
+    {
+        // Released as the entry is erased
+        if (documents.erase(name) == 0)
+        {
+            Error() << "Error: There is no document named \"" << name 
+                    << "\"." << endl;
+            return;
+        }
+        
+        Message() << "Closed the document \"" << name << "\"." << endl;
+        return;
+    }
+    
+    // There must always be a current document
+    if (documents.empty())
+    {
+        Error() << "Error: \"" << name << "\" is the only document, so it "
+                "can't be closed." << endl;
+        return;
+    }
+    
+    // Make the first of the others current; the closed document is released
+    //      when "closed" goes out of scope
+    auto next = documents.begin();
+    WorkspaceDocument closed = std::move(next->second);
+    document_name = next->first;
+    documents.erase(next);
+    
+    SwapDocument(closed);
+    
+    Message() << "Closed the document \"" << name << "\". Now using \"" 
+            << document_name << "\"." << endl;
+}
+
+void InputParser::ProcessDocsCommand(const CommandGrammar::TokenList& tokens)
+{
+    // Docs takes no arguments
+    if (tokens.size() != 1)
+    {
+        Error() << "Invalid \"docs\" command. Valid signature for docs is:" 
+                << endl;
+        out << "> docs" << endl;
+        return;
+    }
+    
+    // Lists every document in order of name, marking the current one
+    const auto describe = [this](const string& name, DOMDocument* document)
+    {
+        const DOMElement* const root = document->getDocumentElement();
+        
+        out << ((name == document_name) ? "* " : "  ") << name;
+        
+        if (root)
+        {
+            out << " (root \"" << LSTR(root->getNodeName()) << "\")";
+        }
+        
+        out << endl;
+    };
+    
+    bool listed = false;
+    
+    for (const auto& entry : documents)
+    {
+        if (!listed && document_name < entry.first)
+        {
+            describe(document_name, doc.get());
+            listed = true;
+        }
+        
+        describe(entry.first, entry.second.doc.get());
+    }
+    
+    if (!listed) { describe(document_name, doc.get()); }
+}
+
+const std::vector<DOMNode*>& InputParser::FindElements(
+        const std::string& name, std::vector<DOMNode*>& found)
+{
+    ScopedTimer timer(command_stats.ForOperation(
+            CommandStats::Operation::Lookup));
+    
+    if (NodePath::IsPath(name))
+    {
+        // A leading "//name" step is answered the same way as a bare name
+        found = paths.Get(name).Evaluate(doc.get(), 
+                [this](const string& tag) -> vector<DOMNode*>
+        {
+            vector<DOMNode*> step_found;
+            return FindElementsByName(tag, step_found);
+        });
+        
+        return found;
+    }
+    
+    return FindElementsByName(name, found);
+}
+
+const std::vector<DOMNode*>& InputParser::FindElementsByName(
+        const std::string& name, std::vector<DOMNode*>& found)
+{
+    // The index's own list, so that a name shared by many elements isn't
+    //      copied on every lookup
+    if (use_index)
+    {
+        return index.Find(name);
+    }
+    
+    // Split the walk between threads; the matches stay in document order
+    if (scan_threads > 1)
+    {
+        found = DOMUtil::FindElementsByTagName(doc.get(), names.Get(name),
+                scan_threads);
+        return found;
+    }
+    
+    // Fall back to walking the whole document
+    DOMNodeList* elements = doc->getElementsByTagName(names.Get(name));
+    const XMLSize_t elements_len = elements->getLength();
+    found.resize(elements_len);
+    
+    for (XMLSize_t i = 0; i < elements_len; ++ i)
+    {
+        found[i] = elements->item(i);
+    }
+    
+    return found;
+}
+
+void InputParser::OutputDocument()
+{
+    using namespace std;
+    
+    // Get root from document
+    DOMElement* root = doc->getDocumentElement();
+    
+    // Create tree walker that will visit all nodes
+    TreeWalkerPtr walker(doc->createTreeWalker(
+            root, DOMNodeFilter::SHOW_ALL, nullptr, true));
+    
+    // Initial call to nextNode() as required by the documentation
+    DOMNode* node = walker->nextNode();
+    
+    // Check for empty tree before proceeding
+    if (!node)
+    {
+        out << "Document is empty." << endl;
+        return;
+    }
+    
+    // While there are still nodes...
+    while (node != nullptr)
+    {
+        // Each sibling is treated as a node and passed to the recursive
+        //      helper function
+        DOMUtil::AppendDocSubTree(output_buffer, 0, node, &out);
+        node = walker->nextSibling();
+    }
+    
+    FlushOutputBuffer();
+}
+
+void InputParser::StreamFile(const std::string& filename, 
+        const std::string& name, const bool print)
+{
+    DocumentStreamer::Result result;
+    
+    try
+    {
+        if (print)
+        {
+            DocumentStreamer::Print(filename, name, DocumentLoader::Options(),
+                    out, result);
+        }
+        else
+        {
+            DocumentStreamer::Count(filename, name, DocumentLoader::Options(),
+                    result);
+        }
+    }
+    
+    catch (const std::runtime_error& err)
+    {
+        Error() << "Error: Failed to stream the file: \"" << filename << "\"" 
+                << endl << err.what() << endl;
+        return;
+    }
+    
+    // Same messages as the "print" command when there's nothing to print
+    if (print && name.empty() && result.printed == 0)
+    {
+        out << "Document is empty." << endl;
+    }
+    
+    else if (!name.empty() && result.matches == 0)
+    {
+        Error() << "No element with the name \"" << name
+                << "\" could be found." << endl;
+    }
+    
+    else if (!print)
+    {
+        out << "The file \"" << filename << "\" contains " 
+                << result.elements << " elements";
+        
+        if (!name.empty())
+        {
+            out << ", " << result.matches << " of them named \"" << name 
+                    << "\"";
+        }
+        
+        out << ". Attributes: " << result.attributes << ", maximum depth: "
+                << result.max_depth << "." << endl;
+    }
+    
+    Message() << "Streamed \"" << filename << "\" (" 
+            << DescribeParse(result.stats) << ")." << endl;
+}
+
+void InputParser::FlushOutputBuffer()
+{
+    out.write(output_buffer.data(), output_buffer.size());
+    out.flush();
+    
+    // clear() keeps the capacity, so the next command reuses the memory
+    output_buffer.clear();
+}
+
+void InputParser::AddElement(const std::string& parent_name, 
+        const std::string& child_name, const std::string& child_content)
+{
+    // Nodes being appended to. An error message is printed if none can be
+    //      selected.
+    vector<DOMNode*> parents;
+    if (!SelectParents(parent_name, parents))
+    {        
+        return;
+    }
+    
+    // Only look the name up once, however many parents there are
+    const XMLCh* const child_tag = names.Get(child_name);
+    
+    // Create a child and append it to each selected parent
+    for (DOMNode* parent : parents)
+    {
+        // Create and append child
+        DOMElement* child = nullptr;
+        {
+            ScopedTimer timer(command_stats.ForOperation(
+                    CommandStats::Operation::Append));
+            child = doc->createElement(child_tag);
+            parent->appendChild(child);
+            index.Insert(child, child_name);
+        }
+        
+        Message() << "Element \"" << child_name << "\" ";
+        
+        // Only add content to child if there is content to add
+        if (!child_content.empty())
+        {
+            //string trim_content = jmhUtilities::trim(child_content);
+            DOMText* child_text = doc->createTextNode(XSTR(child_content));
+            child->appendChild(child_text);
+            Message() << "with content \"" << child_content << "\" ";
+        }
+        
+        // If there is no content, reflect this in the output message
+        else
+        {
+            Message() << "(with no content) ";
+        }
+                
+        Message() << "was successfully appended to parent Element \""
+                << LSTR(parent->getNodeName()) << "\"." << endl;
+    }
+}
+
+void InputParser::AddElements(const std::string& parent_name, 
+        const std::string& child_name, const std::size_t count,
+        const std::vector<std::string>& contents)
+{
+    const auto start = chrono::steady_clock::now();
+    
+    // Resolve the parents once for every child
+    vector<DOMNode*> parents;
+    if (!SelectParents(parent_name, parents))
+    {
+        return;
+    }
+    
+    const XMLCh* const child_tag = names.Get(child_name);
+    const size_t children = contents.empty() ? count : contents.size();
+    
+    // Convert the contents once, however many parents there are
+    vector<unique_ptr<XStr>> texts;
+    texts.reserve(contents.size());
+    
+    for (const string& content : contents)
+    {
+        texts.emplace_back(new XStr(content));
+    }
+    
+    CommandStats::Counter& appends = command_stats.ForOperation(
+            CommandStats::Operation::Append);
+    
+    for (DOMNode* parent : parents)
+    {
+        for (size_t i = 0; i < children; ++ i)
+        {
+            ScopedTimer timer(appends);
+            DOMElement* child = doc->createElement(child_tag);
+            
+            if (!texts.empty())
+            {
+                child->appendChild(doc->createTextNode(
+                        texts[i]->get_unicode_form()));
+            }
+            
+            // Appending at the end keeps the index in document order
+            parent->appendChild(child);
+            index.Insert(child, child_name);
+        }
+    }
+    
+    const double seconds = chrono::duration<double>(
+            chrono::steady_clock::now() - start).count();
+    
+    for (DOMNode* parent : parents)
+    {
+        Message() << children << " Elements \"" << child_name << "\" were "
+                "successfully appended to parent Element \""
+                << LSTR(parent->getNodeName()) << "\"";
+        
+        // The time covers every parent, so only give it once
+        if (parent == parents.back())
+        {
+            Message() << " (" << DescribeTransfer(0, seconds) << ")";
+        }
+        
+        Message() << "." << endl;
+    }
+}
+
+bool InputParser::SelectParents(const std::string& parent_name,
+        std::vector<DOMNode*>& parents)
+{
+    // If user specified root, set parent to root. As a side-effect, elements
+    //      with the name "root" are not supported.
+    if (CommandGrammar::IsRootSpecifier(
+            CommandGrammar::Token{ parent_name.data(), parent_name.size() }))
+    {
+        parents.assign(1, doc->getDocumentElement());
+        return true;
+    }
+
+    // Else search the tree for elements matching the specified name
+    return SelectElements(parent_name, parents);
+}
+
+void InputParser::WriteToFile(const std::string& filename, 
+        const DocumentWriter::Options& options)
+{
+    DocumentWriter::Stats stats;
+    
+    try
+    {
+        ScopedTimer timer(command_stats.ForOperation(
+                CommandStats::Operation::Serialize));
+        DocumentWriter::Write(impl, doc.get(), filename, options, stats);
+    }
+    
+    catch (const std::runtime_error& err)
+    {
+        Error() << "There was an error writing the document to the file: \"" 
+                << filename << "\"" << endl << err.what() << endl;
+        return;
+    }
+    
+    // The document doesn't end with a line break, so end the line here when
+    //      it was written to the console
+    if (filename == "-")
+    {
+        out << endl;
+    }
+    
+    ReportWrite(filename, stats);
+}
+
+void InputParser::StartBackgroundWrite(const std::string& filename, 
+        const DocumentWriter::Options& options)
+{
+    if (filename == "-")
+    {
+        Error() << "Error: Background writes can't go to standard out." << endl;
+        return;
+    }
+    
+    // Copy the document, so that commands can go on changing the original
+    //      while the copy is written
+    const auto start = chrono::steady_clock::now();
+    shared_ptr<DOMDocument> snapshot;
+    
+    try
+    {
+        snapshot.reset(DOMUtil::CloneDocument(impl, doc.get()), 
+                DOMDeleter<DOMDocument>());
+    }
+    
+    catch (const DOMException& err)
+    {
+        Error() << "Error: Failed to copy the document for writing." << endl
+                << LSTR(err.getMessage()) << endl;
+        return;
+    }
+    
+    const double copy_seconds = chrono::duration<double>(
+            chrono::steady_clock::now() - start).count();
+    
+    BackgroundWrite job;
+    job.id = next_job_id ++;
+    job.filename = filename;
+    job.started = chrono::steady_clock::now();
+    
+    // The copy is only ever touched by the new thread. Every error is caught
+    //      there and handed back as part of the outcome.
+    DOMImplementation* const implementation = impl;
+    job.outcome = async(launch::async, 
+            [implementation, snapshot, filename, options]()
+            {
+                WriteOutcome outcome;
+                
+                try
+                {
+                    DocumentWriter::Write(implementation, snapshot.get(), 
+                            filename, options, outcome.stats);
+                }
+                
+                catch (const std::runtime_error& err)
+                {
+                    outcome.error = err.what();
+                }
+                
+                catch (...)
+                {
+                    outcome.error = "An unexpected error occurred.";
+                }
+                
+                return outcome;
+            });
+    
+    Message() << "Job " << job.id << " started writing the document to the "
+            "file: \"" << filename << "\" (copied in " 
+            << DescribeTransfer(0, copy_seconds) << ")." << endl;
+    
+    jobs.push_back(std::move(job));
+}
+
+void InputParser::FinishJob(BackgroundWrite& job)
+{
+    const WriteOutcome outcome = job.outcome.get();
+    
+    if (!outcome.error.empty())
+    {
+        Error() << "Job " << job.id << ": There was an error writing the "
+                "document to the file: \"" << job.filename << "\"" << endl 
+                << outcome.error << endl;
+        return;
+    }
+    
+    Message() << "Job " << job.id << ": ";
+    ReportWrite(job.filename, outcome.stats);
+}
+
+void InputParser::WaitForJobs()
+{
+    if (jobs.empty())
+    {
+        return;
+    }
+    
+    Message() << "Waiting for " << jobs.size() << " background write(s) to "
+            "finish..." << endl;
+    
+    for (BackgroundWrite& job : jobs)
+    {
+        FinishJob(job);
+    }
+    
+    jobs.clear();
+}
+
+void InputParser::ReportWrite(const std::string& filename, 
+        const DocumentWriter::Stats& stats)
+{
+    Message() << "The document was successfully written to the file: \""
+            << filename << "\" (" 
+            << DescribeTransfer(stats.bytes_in, stats.seconds);
+    
+    if (stats.compressed && stats.bytes > 0)
+    {
+        // Format separately, so that out's flags are untouched
+        ostringstream ratio;
+        ratio << fixed << setprecision(1) 
+                << static_cast<double>(stats.bytes_in) / stats.bytes;
+        
+        Message() << ", compressed to " << stats.bytes << " bytes, " 
+                << ratio.str() << ":1";
+    }
+    
+    if (stats.threads > 1)
+    {
+        Message() << ", on " << stats.threads << " threads";
+    }
+    
+    Message() << ")." << endl;
+}
+
+void InputParser::AddAttribute( const std::string& parent_name,
+        const std::string& attr_name, const std::string& attr_val)
 {    
-    // Get collection of elements
-    DOMNodeList* elements = doc->getElementsByTagName(XSTR(parent_name));
+    // Get collection of elements. An error message is printed if none can be
+    //      selected.
+    vector<DOMNode*> parents;
+    if (!SelectElements(parent_name, parents))
+    {
+        return;
+    }
     
-    // Cast result to a DOMElement so that we can access addAttribute()
-    DOMElement* parent = 
-            static_cast<DOMElement*>(DOMUtil::SelectNodeFromList(elements));
+    // Only look the name up once, however many elements there are
+    const XMLCh* const attr_key = names.Get(attr_name);
     
-    // Only append if parent could be found
-    if (parent)
+    for (DOMNode* node : parents)
     {  
-        parent->setAttribute(XSTR(attr_name), XSTR(attr_val));
+        // Cast to a DOMElement so that we can access setAttribute()
+        DOMElement* parent = static_cast<DOMElement*>(node);
+        parent->setAttribute(attr_key, XSTR(attr_val));
         
-        cout << "Attribute \"" << attr_name << "\" with value \"" << attr_val
-                << "\" was successfully added to Element \"" << parent_name
-                << "\"." << endl;
+        Message() << "Attribute \"" << attr_name << "\" with value \"" 
+                << attr_val << "\" was successfully added to Element \"" 
+                << parent_name << "\"." << endl;
+    }
+}
+
+void InputParser::AddAttributes(const std::string& parent_name, 
+        const std::vector<std::pair<std::string, std::string>>& attributes)
+{
+    vector<DOMNode*> parents;
+    if (!SelectElements(parent_name, parents))
+    {
+        return;
     }
     
-    // If element couldn't be found, print error message
-    else
+    // Convert each key and value once, however many elements there are
+    vector<const XMLCh*> keys;
+    vector<unique_ptr<XStr>> values;
+    keys.reserve(attributes.size());
+    values.reserve(attributes.size());
+    
+    for (const auto& attribute : attributes)
     {
-        cout << "No element with the name \"" << parent_name
-                << "\" could be found." << endl;
+        keys.push_back(names.Get(attribute.first));
+        values.emplace_back(new XStr(attribute.second));
+    }
+    
+    for (DOMNode* node : parents)
+    {
+        DOMElement* parent = static_cast<DOMElement*>(node);
+        
+        for (size_t i = 0; i < keys.size(); ++ i)
+        {
+            parent->setAttribute(keys[i], values[i]->get_unicode_form());
+        }
+        
+        Message() << attributes.size() << " Attributes were successfully "
+                "added to Element \"" << parent_name << "\"." << endl;
     }
 }
 
-void InputParser::ProcessHelpCommand()
+void InputParser::ProcessHelpCommand(const CommandGrammar::TokenList& tokens)
 {               
+    // Help takes no arguments
+    if (tokens.size() != 1)
+    {
+        OutputInvalidCommand();
+        return;
+    }
+    
     // Collection of command names
     vector<string> cmd_names =
     {
         "add element",
         "add attribute",
+        "add elements",
+        "add attributes",
         "print",
         "write",
         "delete",
+        "lookup",
+        "load",
+        "stream print",
+        "stream count",
+        "bench",
+        "cache",
+        "memory",
+        "jobs",
+        "wait",
+        "verbosity",
+        "stats",
+        "new",
+        "use",
+        "close",
+        "docs",
+        "paths",
         "help",
         "print"
     };
@@ -515,82 +1859,218 @@ void InputParser::ProcessHelpCommand()
         "Add Attribute [parent name] [key] [value]: Adds an attribute with the "
         "specified key/value pair to the specified parent."
         ,
+        "Add Elements [parent name] [child name] [count|content,...]: Appends "
+        "[count] empty elements with the specified name to the specified "
+        "parent, or one element for each item of a comma-separated list of "
+        "contents. Much faster than adding the elements one by one."
+        ,
+        "Add Attributes [parent name] [key] [value] <[key] [value]...>: Adds "
+        "every key/value pair given to the specified parent."
+        ,
         "Print <node name?>: Outputs the document to standard out. If "
         "a    <node name> is specified, it will be used as the root of the "
         "output document."
         ,
-        "Write [file path]: Outputs the current document to a file "
-        "specified by [file path]."
+        "Write [file path] <pretty?> <buffer=KB?> <threads=N?> "
+        "<gzip|zstd|nocompress?> <background?>: Outputs the current "
+        "document to a file specified by [file path], or to standard out if "
+        "it is \"-\", or to an open file descriptor N if it is \"fd:N\". "
+        "\"pretty\" indents the output, and \"buffer\" sets the size of the "
+        "output buffer (1024 KB by default). \"threads\" splits the "
+        "children of the root element between up to N threads (1 to 256), "
+        "with the same output as one thread. Files ending in .gz or .zst are "
+        "compressed; \"gzip\", \"zstd\" or \"nocompress\" override this. "
+        "\"background\" writes a copy of the document on another thread, so "
+        "that other commands can be entered in the meantime."
         ,
         "Delete [element name]: Finds the element specified by [element name], "
         "removes it from the document, then frees it from memory."
         ,
+        "Lookup <index|scan|parallel?> <threads?>: Chooses how elements are "
+        "found by name. \"index\" (the default) uses a name index that is "
+        "kept up to date as the document changes; \"scan\" searches the "
+        "whole document for every command, and can be used to validate the "
+        "index. \"parallel\" scans the document on several threads (one "
+        "per core unless given, up to 256), listing matches in the same "
+        "order as \"scan\"."
+        ,
+        "Load [file path] <novalidate?> <nonamespaces?> <nommap?>: Replaces "
+        "the current document with one parsed from an XML file. Validation "
+        "and namespace processing can be turned off to parse faster. Regular "
+        "files are memory-mapped unless \"nommap\" is given."
+        ,
+        "Stream Print [file path] <element name?>: Prints an XML file (or "
+        "each element named <element name>) as it is parsed, without "
+        "loading it. Works on files too large to load."
+        ,
+        "Stream Count [file path] <element name?>: Counts the elements of an "
+        "XML file (and those named <element name>) without loading it."
+        ,
+        "Bench <transcode|strings> <size?>: Measures how many strings per "
+        "second can be converted to and from the encoding used by Xerces-C "
+        "(\"transcode\"), or how many characters per second can be trimmed "
+        "and split (\"strings\")."
+        ,
+        "Cache <clear?>: Reports how often element and attribute names were "
+        "found in the name cache rather than converted again, and paths in "
+        "the path cache rather than compiled again. \"clear\" empties both "
+        "caches."
+        ,
+        "Memory: Reports how much memory the arena of the current document "
+        "has handed out and reserved."
+        ,
+        "Jobs: Lists the background writes that are still running, and "
+        "reports those that have finished."
+        ,
+        "Wait <job number?>: Waits for a background write (or all of them) "
+        "to finish, then reports the outcome."
+        ,
+        "Verbosity <quiet|normal?>: Chooses whether commands confirm what "
+        "they did (\"normal\"), or only report errors (\"quiet\"), in which "
+        "case a summary is printed at the end of each script."
+        ,
+        "Stats <clear|name?>: Reports how many times each command was run "
+        "and how long it took (total, mean, maximum, and estimated median and "
+        "99th percentile), as well as the element lookups, appends, removals "
+        "and serializations. Given the name of a command, or of an operation "
+        "such as \"+lookup\", prints a histogram of its latency. \"clear\" "
+        "resets the statistics."
+        ,
+        "New [document name] <root name?>: Adds an empty document (with a "
+        "root element named \"Assignment7\" unless another name is given) "
+        "to the workspace, and makes it the current one. Every other command "
+        "works on the current document. The first document is \"main\"."
+        ,
+        "Use [document name]: Makes another document of the workspace the "
+        "current one."
+        ,
+        "Close <document name?>: Releases a document (the current one by "
+        "default). Closing the current document makes the first of the "
+        "others current; the last document can't be closed."
+        ,
+        "Docs: Lists the documents of the workspace, marking the current one "
+        "with \"*\"."
+        ,
+        "Paths: Wherever an existing element is named (add, delete, print), "
+        "a path may be given instead: \"/a/b\" (the \"b\" children of the "
+        "root \"a\"), \"//b\" (\"b\" anywhere), \"*\" (any element), "
+        "\"b[2]\" (the second \"b\" of its parent), \"b[@key]\" and "
+        "\"b[@key=value]\" (\"b\" elements with that attribute)."
+        ,
         "Help: Displays this help menu."
         ,
         "Quit: \"quit\" or \"exit\" may be used to quit the program."
     };
     
-    // Always set this to the longest string
-    size_t lhs_size = sizeof("add attribute");
+    // Wide enough for the longest name, plus a space
+    const size_t lhs_size = max_element(cmd_names.begin(), cmd_names.end(),
+            [](const string& a, const string& b) 
+            {
+                return a.size() < b.size();
+            })->size() + 1;
     
     // Invoke output column method
     // Print assumes an 80 character wide display for standard out
-    CmdUtil::Output2ColumnTable(cmd_names, cmd_desc, lhs_size, 80 - lhs_size);
+    CmdUtil::Output2ColumnTable(cmd_names, cmd_desc, lhs_size, 80 - lhs_size, 
+            out);
 }
 
 void InputParser::DeleteElement(const std::string& node_name)
 {    
-    // Get all elements matching the input name
-    DOMNodeList* elements = doc->getElementsByTagName(XSTR(node_name));
+    // Get all elements matching the input name. If there are multiple nodes
+    //      of the same name, the selection policy decides which to delete.
+    vector<DOMNode*> targets;
+    if (!SelectElements(node_name, targets))
+    {
+        return;
+    }
     
-    // If there are multiple nodes of the same name, user chooses one
-    DOMNode* target = DOMUtil::SelectNodeFromList(elements);
+    // Give user chance to opt out before permanently deleting data. Batch
+    //      runs have no one to ask, so the answer is always yes.
+    bool del = auto_confirm || CmdUtil::YesNoPrompt(
+            "Are you sure you would like to delete this node?");
+
+    if (!del) { return; }
     
-    // If node is valid, attempt to delete it
-    if (target)
-    {        
-        // Give user chance to opt out before permanently deleting data
-        bool del = CmdUtil::YesNoPrompt(
-                "Are you sure you would like to delete this node?");
-                
-        if (del) // If user wishes to delete...
+    // Delete in reverse document order, so that if one target contains
+    //      another, the inner one is removed before the outer one frees it
+    for (auto target = targets.rbegin(); target != targets.rend(); ++ target)
+    {
+        bool removed = false;
         {
-            if (DOMUtil::RemoveNodeFromParent(target))
-            {
-                cout << "Successfully deleted element \"" 
-                        << node_name << "\"" << endl;
-            }
-            else
-            {
-                cout << "Error: Element \"" << node_name << "\" could not be "
-                        "removed from the document." << endl;
-            }
+            ScopedTimer timer(command_stats.ForOperation(
+                    CommandStats::Operation::Remove));
+            removed = DOMUtil::RemoveNodeFromParent(*target, &index);
         }
-    }
         
-    else // If no nodes with name node_name
-    {
-        cout << "No element with the name \"" << node_name
-                << "\" could be found." << endl;
+        if (removed)
+        {
+            Message() << "Successfully deleted element \"" 
+                    << node_name << "\"" << endl;
+        }
+        else
+        {
+            Error() << "Error: Element \"" << node_name << "\" could not be "
+                    "removed from the document." << endl;
+        }
     }
 }
 
 void InputParser::PrintSubTree(const std::string& root_name)
 {    
-    // Get collection of elements matching root_name
-    DOMNodeList* elements = doc->getElementsByTagName(XSTR(root_name));
-
-    // Get input from user if there are multiple matches
-    DOMNode* target = DOMUtil::SelectNodeFromList(elements);
+    // Get collection of elements matching root_name, and resolve multiple
+    //      matches using the selection policy
+    vector<DOMNode*> targets;
+    
+    if (SelectElements(root_name, targets))
+    {
+        for (DOMNode* target : targets)
+        {
+            DOMUtil::AppendDocSubTree(output_buffer, 0, target, &out);
+        }
+        
+        FlushOutputBuffer();
+    }
+}
 
-    if (target)
+bool InputParser::SelectElements(const std::string& name, 
+        std::vector<DOMNode*>& targets)
+{
+    vector<DOMNode*> found;
+    const vector<DOMNode*>* matches_ptr = nullptr;
+    
+    try
+    {
+        matches_ptr = &FindElements(name, found);
+    }
+    
+    catch (const std::runtime_error& err)
     {
-        DOMUtil::OutputDocSubTree(0, target);
+        Error() << "Error: " << err.what() << endl;
+        return false;
     }
     
-    else // Display error if target cannot be found
+    // Only the selected nodes are copied, since the commands go on to change
+    //      the document
+    const vector<DOMNode*>& matches = *matches_ptr;
+    
+    if (matches.empty())
     {
-        cout << "No element with the name \"" << root_name
+        Error() << "No element " << (NodePath::IsPath(name) ? "matching the "
+                "path \"" : "with the name \"") << name 
                 << "\" could be found." << endl;
+        return false;
+    }
+    
+    targets = DOMUtil::SelectNodesFromList(matches, selection_policy);
+    
+    // Only the "error" policy declines to choose between several matches
+    if (targets.empty())
+    {
+        Error() << "Error: The name \"" << name << "\" matches " 
+                << matches.size() << " elements." << endl;
+        return false;
     }
-}
\ No newline at end of file
+    
+    return true;
+}
@@ -15,7 +15,18 @@
 #include "LocalStr.h"
 #include "CmdUtil.h"
 #include "DOMUtil.h"
+#include "CommandGrammar.h"
+#include "NodeIndex.h"
+#include "NameCache.h"
+#include "NodePath.h"
+#include "ArenaMemoryManager.h"
+#include "DocumentLoader.h"
+#include "DocumentStreamer.h"
+#include "DocumentWriter.h"
+#include "Benchmark.h"
+#include "CommandStats.h"
 
+#include <algorithm>    // for max_element
 #include <sstream>
 #include <string>
 #include <regex>
@@ -24,6 +35,13 @@
 #include <cassert>      // for cassert
 #include <iomanip>      // for setw
 #include <fstream>      // for ifstream--
+#include <cerrno>       // for errno
+#include <cstdlib>      // for strtoul
+#include <chrono>       // for steady_clock
+#include <future>       // for async, future
+#include <memory>       // for shared_ptr
+#include <map>          // for the documents of the workspace
+#include <thread>       // for hardware_concurrency
 
 #include <xercesc/util/PlatformUtils.hpp>
 #include <xercesc/util/OutOfMemoryException.hpp>
@@ -35,8 +53,8 @@
 #include <xercesc/util/XMLString.hpp>
 
 /**
- * This class continually prompts the user for commands, processing each one
- *      using regular expressions. These commands allow the user to manipulate
+ * This class continually prompts the user for commands, splitting each one
+ *      into tokens and dispatching it on its first keyword. These commands allow the user to manipulate
  *      a DOM document, and are implemented using the Xerces-C library. To test
  *      the result of many commands quickly, call Run() with a \c std::ostream 
  *      (or \c std::string naming a text file) containing these commands. 
@@ -49,14 +67,32 @@ class InputParser
 public:
     
     /**
-     * Default constructor. Calls Initialize().
+     * How much the parser reports about the commands it runs.
+     */
+    enum class Verbosity
+    {
+        /**
+         * Only errors and the output asked for (such as that of "print") are
+         *      printed, followed by a summary at the end of each script.
+         */
+        Quiet,
+        
+        /** Every command confirms what it did. */
+        Normal
+    };
+    
+    /**
+     * Constructor. Calls Initialize().
+     * @param out Stream that receives everything the parser prints; standard
+     *      out by default. Parsers writing to different streams can run on
+     *      different threads.
      * @throw DOMException: Exceptions thrown by 
      *      \c DOMImplementation::createDocument, see:
      *      https://xerces.apache.org/xerces-c/apiDocs-3/classDOMImplementation.htm
      * @throw std::runtime_error: If the factory methods for \c impl or \c doc 
      *      return null.
      */
-    InputParser();
+    explicit InputParser(std::ostream& out = std::cout);
     
     /**
      * First of 3 variants of the \c Run method. When called with no
@@ -70,8 +106,10 @@ public:
      * Second of the 3 \c Run variants. When called with an \c std::ostream as
      *      an argument, the \c Run method will process lines of input from the
      *      stream until it fails or reaches EOF. Control will then be given
-     *      to the user with a parameterless call to \c Run. This method will
-     *      return early if a "Quit" command is read from the stream.
+     *      to the user with a parameterless call to \c Run, unless the parser
+     *      is in batch mode, in which case this method simply returns. This
+     *      method will return early if a "Quit" command is read from the
+     *      stream.
      * @param exec the \c std::istream to read commands from
      */
     void Run(std::istream& exec);
@@ -81,15 +119,126 @@ public:
      *      argument, the \c Run method will attempt to open a file at the path
      *      specified in \c exec_filename. If the stream is constructed in a
      *      valid state, it will be passed to \c Run(std::istream&) to be used
-     *      as an Autoexec. Otherwise \c Run is called with no parameters. A
-     *      message is output indicating whether the file was successfully 
-     *      opened.
+     *      as an Autoexec. Otherwise \c Run is called with no parameters
+     *      (except in batch mode). A message is output indicating whether the
+     *      file was successfully opened.
      * @param exec_filename the path to the file being opened
+     * @return \c true if the file was opened and run, \c false otherwise.
+     */
+    bool Run(const std::string& exec_filename);
+    
+    /**
+     * Turns batch mode on or off. In batch mode the parser never waits on
+     *      standard input: \c Run(std::istream&) returns when the stream is
+     *      exhausted, confirmations are answered automatically, and a
+     *      selection policy of \c Prompt is replaced with \c First.
+     * @param batch \c true to run unattended.
+     */
+    void SetBatchMode(const bool batch);
+    
+    /**
+     * Sets how a name matching several elements is resolved. See
+     *      \c DOMUtil::SelectNodesFromList().
+     * @param policy The policy to apply from now on.
+     */
+    void SetSelectionPolicy(const DOMUtil::SelectionPolicy policy);
+    
+    /**
+     * Sets how much the parser reports about the commands it runs. Printing
+     *      a confirmation for every command can take longer than the command
+     *      itself, so large scripts run faster when quiet.
+     * @param level The verbosity to apply from now on.
+     */
+    void SetVerbosity(const Verbosity level);
+    
+    /**
+     * Converts the name of a verbosity level ("quiet" or "normal", not
+     *      case-sensitive) to its value.
+     * @param name  Name of the level.
+     * @param level Receives the level if \c name is valid.
+     * @return \c true if \c name names a level.
+     */
+    static bool ParseVerbosity(const std::string& name, Verbosity& level);
+    
+    /**
+     * Prints the timing and call counts of every command and DOM operation
+     *      run so far, as the "stats" command does.
+     */
+    void OutputStats() const;
+    
+    /**
+     * @return The number of commands run by the last script, or so far by
+     *      the current one.
+     */
+    std::size_t CommandsRun() const;
+    
+    /**
+     * @return The number of those commands that reported an error.
+     */
+    std::size_t CommandsFailed() const;
+    
+    /**
+     * Replaces the working document with one parsed from an XML file. If the
+     *      file can't be parsed, the current document is kept and an error
+     *      message is printed. Otherwise, the size of the file and the time
+     *      taken to parse it are reported.
+     * @param filename Path to the XML file to load.
+     * @param options  Parser settings, see \c DocumentLoader::Options.
+     * @return \c true if the document was replaced, \c false otherwise.
      */
-    void Run(const std::string& exec_filename);
+    bool Load(const std::string& filename, 
+            const DocumentLoader::Options& options);
     
 private:
     
+    /**
+     * What a background write produced.
+     */
+    struct WriteOutcome
+    {
+        /** Measurements taken while writing. */
+        DocumentWriter::Stats stats;
+        
+        /** Why the write failed, or empty if it succeeded. */
+        std::string error;
+    };
+    
+    /**
+     * A document of the workspace other than the current one, set aside
+     *      until a "use" command makes it current again. Holds the same
+     *      state as \c arena, \c doc and \c index do for the current one.
+     */
+    struct WorkspaceDocument
+    {
+        /** Memory for the document; declared first, so it is freed last. */
+        std::unique_ptr<ArenaMemoryManager> arena;
+        
+        /** The document. */
+        DocumentPtr doc;
+        
+        /** Index of element names to the elements of \c doc. */
+        NodeIndex index;
+    };
+    
+    /**
+     * A copy of the document being written on another thread. See
+     *      StartBackgroundWrite().
+     */
+    struct BackgroundWrite
+    {
+        /** Number the job is known by in the "jobs" and "wait" commands. */
+        unsigned id;
+        
+        /** Destination the document is being written to. */
+        std::string filename;
+        
+        /** When the job was started. */
+        std::chrono::steady_clock::time_point started;
+        
+        /** Becomes ready when the write is over. */
+        std::future<WriteOutcome> outcome;
+    };
+    
     /**
      * Initializes the \c InputReader by calling the factory methods for
      *      \c impl and \c doc.
@@ -102,8 +251,28 @@ private:
     void Initialize();
     
     /**
-     * Parses an individual command and processes it by calling 
-     *      \c ParseCommandString
+     * Creates an empty document.
+     * @param document_arena Memory for the document's nodes. Must outlive
+     *      the document.
+     * @param root           Name of the root element.
+     * @return The new document, which is never null.
+     * @throw std::runtime_error: If the factory method for the document
+     *      returns null.
+     */
+    DocumentPtr CreateDocument(ArenaMemoryManager& document_arena, 
+            const std::string& root);
+    
+    /**
+     * Exchanges the current document (with its arena and index) for one
+     *      that was set aside.
+     * @param other The document to make current; receives the document that
+     *      was current.
+     */
+    void SwapDocument(WorkspaceDocument& other);
+    
+    /**
+     * Splits an individual command into tokens and processes it by calling 
+     *      \c DispatchCommand
      * @param strUserEntry The command to be parsed
      * @return \c false if a valid "Quit" command was processed, \c true otherwise.
      *      Note that this method still returns \c true for invalid commands, the
@@ -113,62 +282,293 @@ private:
     bool ParseCommand(const std::string& strUserEntry);
     
     /**
-     * Check for a valid basic command. If the command can't be identified
-     *      as any of the basic types, a simple help message will be printed.
-     * @param strUserEntry command string entered by the user
+     * Check for a valid basic command by looking up the first token in the
+     *      dispatch table, then pass the tokens to that command's handler. If
+     *      the command can't be identified as any of the basic types, a simple
+     *      help message will be printed.
+     * @param tokens tokens of the command entered by the user
+     */
+    void DispatchCommand(const CommandGrammar::TokenList& tokens);
+    
+    /**
+     * Prints the message listing the acceptable basic commands.
+     */
+    void OutputInvalidCommand();
+    
+    /**
+     * Stream for confirmations and other messages that are only printed at
+     *      the \c Normal verbosity.
+     * @return \c out, or a stream that discards its output when quiet.
+     */
+    std::ostream& Message();
+    
+    /**
+     * Stream for error messages, which are printed at every verbosity. The
+     *      command being run is counted as failed.
+     * @return \c out.
+     */
+    std::ostream& Error();
+    
+    /**
+     * Prints how many commands a script ran, how many of them failed, and
+     *      how long it took.
+     * @param seconds Time taken by the script.
+     */
+    void OutputSummary(const double seconds);
+    
+    /**
+     * Analyzes a "verbosity" command. With no argument, the current level is
+     *      reported; otherwise the level named by the argument is applied.
+     * @param tokens tokens of the command entered by the user.
+     */
+    void ProcessVerbosityCommand(const CommandGrammar::TokenList& tokens);
+    
+    /**
+     * Analyzes a "stats" command. With no argument, the timing of every
+     *      command and operation is reported; "clear" resets it, and the name
+     *      of a command or operation prints its latency histogram.
+     * @param tokens tokens of the command entered by the user.
      */
-    void ParseCommandString(const std::string& strUserEntry) ;
+    void ProcessStatsCommand(const CommandGrammar::TokenList& tokens);
     
     /**
      * Handle an add command entered by the user. This function distinguishes
      *      the "element" commands from the "attribute" commands, and will also
      *      output an error message if the "add" command fits neither valid
      *      category.
-     * @param strUserEntry command string entered by the user
+     * @param tokens tokens of the command entered by the user
      */
-    void ProcessAddCommand(const std::string& strUserEntry) ;
+    void ProcessAddCommand(const CommandGrammar::TokenList& tokens);
     
     /**
      * Handle an add element command entered by the user. This method pulls
-     *      the individual arguments out of the string and passes them to
+     *      the individual arguments out of the tokens and passes them to
      *      <code>AddElement</code>. An error message will be printed if the
-     *      input string is not well-formed.
-     * @param strUserEntry command string entered by the user
+     *      command is not well-formed.
+     * @param tokens tokens of the command entered by the user
      */
-    void ProcessAddElementCommand(const std::string& strUserEntry) ;
+    void ProcessAddElementCommand(const CommandGrammar::TokenList& tokens);
     
     /**
      * Handle an add attribute command entered by the user. This method pulls
-     *      the individual arguments out of the string and passes them to
+     *      the individual arguments out of the tokens and passes them to
      *      <code>AddAttribute</code>. An error message will be printed if the
-     *      input string is not well-formed.
-     * @param strUserEntry command string entered by the user
+     *      command is not well-formed.
+     * @param tokens tokens of the command entered by the user
+     */
+    void ProcessAddAttributeCommand(const CommandGrammar::TokenList& tokens);
+    
+    /**
+     * Handle an add elements command, which appends many children in one
+     *      go. The last argument is either the number of (empty) children to
+     *      append, or a comma-separated list with the content of each child.
+     *      The arguments are passed to <code>AddElements</code>. An error
+     *      message will be printed if the command is not well-formed.
+     * @param tokens tokens of the command entered by the user
      */
-    void ProcessAddAttributeCommand(const std::string& strUserEntry);
+    void ProcessAddElementsCommand(const CommandGrammar::TokenList& tokens);
+    
+    /**
+     * Handle an add attributes command, which adds any number of key/value
+     *      pairs to an element in one go. The arguments are passed to
+     *      <code>AddAttributes</code>. An error message will be printed if the
+     *      command is not well-formed.
+     * @param tokens tokens of the command entered by the user
+     */
+    void ProcessAddAttributesCommand(const CommandGrammar::TokenList& tokens);
     
     /**
      * Analyzes a "delete" command entered by the user to determine if it's
      *      well-formed or not. If it is well formed, the element name
      *      parameter is passed to DeleteElement().
-     * @param strUserEntry command string entered by the user.
+     * @param tokens tokens of the command entered by the user.
      */
-    void ProcessDeleteCommand(const std::string& strUserEntry);
+    void ProcessDeleteCommand(const CommandGrammar::TokenList& tokens);
     
     /**
      * Analyzes a "print" command to determine if it is valid.
      *      If it is valid, check for an argument for the root node
      *      and display the appropriate document or document sub-tree to
      *      standard out.
-     * @param strUserEntry command string entered by the user.
+     * @param tokens tokens of the command entered by the user.
      */
-    void ProcessPrintCommand(const std::string& strUserEntry);
+    void ProcessPrintCommand(const CommandGrammar::TokenList& tokens);
     
     /**
      * Analyzes a "write" command to determine if it's well-formed. If it is,
-     * the file path parameter is passed to WriteToFile().
-     * @param strUserEntry command string entered by the user.
+     * the destination and any options ("pretty", "buffer=KB", "gzip", "zstd",
+     * "nocompress") are passed to WriteToFile(), or to StartBackgroundWrite()
+     * if the "background" option is given.
+     * @param tokens tokens of the command entered by the user.
+     */
+    void ProcessWriteCommand(const CommandGrammar::TokenList& tokens);
+    
+    /**
+     * Analyzes a "jobs" command, which lists the background writes. Writes
+     *      that have finished are reported and removed from the list.
+     * @param tokens tokens of the command entered by the user.
+     */
+    void ProcessJobsCommand(const CommandGrammar::TokenList& tokens);
+    
+    /**
+     * Analyzes a "wait" command, which waits for one background write (given
+     *      its number) or all of them to finish, then reports the outcome.
+     * @param tokens tokens of the command entered by the user.
+     */
+    void ProcessWaitCommand(const CommandGrammar::TokenList& tokens);
+    
+    /**
+     * Analyzes a "lookup" command, which selects how elements are found by
+     *      name: through \c index, or by scanning the whole document with
+     *      \c getElementsByTagName (useful to validate the index), or by
+     *      scanning it on several threads with
+     *      \c DOMUtil::FindElementsByTagName(). With no argument, the current
+     *      mode is reported.
+     * @param tokens tokens of the command entered by the user.
+     */
+    void ProcessLookupCommand(const CommandGrammar::TokenList& tokens);
+    
+    /**
+     * Analyzes a "load" command. The first argument is the path of the file
+     *      to load, and is passed to Load() along with any parser options
+     *      ("novalidate", "nonamespaces", "nommap") that follow it.
+     * @param tokens tokens of the command entered by the user.
+     */
+    void ProcessLoadCommand(const CommandGrammar::TokenList& tokens);
+    
+    /**
+     * Analyzes a "stream" command, which prints or counts the elements of an
+     *      XML file without loading it. If the command is well-formed, its
+     *      arguments are passed to StreamFile().
+     * @param tokens tokens of the command entered by the user.
+     */
+    void ProcessStreamCommand(const CommandGrammar::TokenList& tokens);
+    
+    /**
+     * Prints or counts an XML file with \c DocumentStreamer, then reports
+     *      what was found. The working document is not affected.
+     * @param filename Path to the file to stream.
+     * @param name     Name of the elements to print or count, or empty for
+     *      the whole document.
+     * @param print    \c true to print the file, \c false to count it.
+     */
+    void StreamFile(const std::string& filename, const std::string& name,
+            const bool print);
+    
+    /**
+     * Describes how a file was read and how quickly, for the messages of the
+     *      "load" and "stream" commands.
+     * @param stats Measurements taken while parsing the file.
+     * @return e.g. "memory-mapped, 1048576 bytes in 12.500 ms, 80.0 MB/s"
+     */
+    static std::string DescribeParse(const DocumentLoader::Stats& stats);
+    
+    /**
+     * Describes the size and speed of a read or write.
+     * @param bytes   Number of bytes transferred, or zero if unknown.
+     * @param seconds Time taken.
+     * @return e.g. "1048576 bytes in 12.500 ms, 80.0 MB/s"
+     */
+    static std::string DescribeTransfer(const std::uint64_t bytes, 
+            const double seconds);
+    
+    /**
+     * Converts the number of threads given to a command.
+     * @param text    Text of the number.
+     * @param threads Receives the number if \c text is valid.
+     * @return \c true if \c text is a number from 1 to 256.
+     */
+    static bool ParseThreadCount(const std::string& text,
+            std::size_t& threads);
+    
+    /**
+     * Analyzes a "bench" command, which runs one of the micro-benchmarks in
+     *      \c Benchmark and prints its results. The optional argument sets
+     *      the number of iterations ("transcode") or the length of the line
+     *      ("strings").
+     * @param tokens tokens of the command entered by the user.
+     */
+    void ProcessBenchCommand(const CommandGrammar::TokenList& tokens);
+    
+    /**
+     * Analyzes a "cache" command. With no argument, the size and hit rate of
+     *      \c names are reported; "cache clear" empties it.
+     * @param tokens tokens of the command entered by the user.
+     */
+    void ProcessCacheCommand(const CommandGrammar::TokenList& tokens);
+    
+    /**
+     * Analyzes a "memory" command, which reports the memory use of \c arena.
+     * @param tokens tokens of the command entered by the user.
+     */
+    void ProcessMemoryCommand(const CommandGrammar::TokenList& tokens);
+    
+    /**
+     * Analyzes a "new" command, which adds an empty document to the
+     *      workspace and makes it the current one.
+     * @param tokens tokens of the command entered by the user.
      */
-    void ProcessWriteCommand(const std::string& strUserEntry);
+    void ProcessNewCommand(const CommandGrammar::TokenList& tokens);
+    
+    /**
+     * Analyzes a "use" command, which makes another document of the
+     *      workspace the current one.
+     * @param tokens tokens of the command entered by the user.
+     */
+    void ProcessUseCommand(const CommandGrammar::TokenList& tokens);
+    
+    /**
+     * Analyzes a "close" command, which releases a document of the
+     *      workspace. Closing the current document makes the first of the
+     *      others (by name) current.
+     * @param tokens tokens of the command entered by the user.
+     */
+    void ProcessCloseCommand(const CommandGrammar::TokenList& tokens);
+    
+    /**
+     * Analyzes a "docs" command, which lists the documents of the workspace.
+     * @param tokens tokens of the command entered by the user.
+     */
+    void ProcessDocsCommand(const CommandGrammar::TokenList& tokens);
+    
+    /**
+     * Finds every element addressed by a name or a path (see \c NodePath).
+     *      Paths are compiled through \c paths.
+     * @param name  Tag name or path of the elements to find.
+     * @param found Holds the matches when they have to be gathered, rather
+     *      than read straight from \c index.
+     * @return The matching elements, in document order: either \c found or
+     *      a list owned by \c index, which is valid until the document is
+     *      next changed.
+     * @throws std::runtime_error if \c name is not a valid path.
+     */
+    const std::vector<XERCES_CPP_NAMESPACE::DOMNode*>& FindElements(
+            const std::string& name,
+            std::vector<XERCES_CPP_NAMESPACE::DOMNode*>& found);
+    
+    /**
+     * Finds every element with the given name, using either \c index or a
+     *      scan of the document (on \c scan_threads threads) depending on
+     *      \c use_index.
+     * @param name  Tag name of the elements to find.
+     * @param found Holds the matches when they are found by scanning.
+     * @return The matching elements, in document order; see FindElements().
+     */
+    const std::vector<XERCES_CPP_NAMESPACE::DOMNode*>& FindElementsByName(
+            const std::string& name,
+            std::vector<XERCES_CPP_NAMESPACE::DOMNode*>& found);
+    
+    /**
+     * Finds every element with the given name or path, then narrows the
+     *      matches down according to \c selection_policy. If no element
+     *      matches, the path is invalid, or the policy refuses to choose
+     *      between several, an error message is printed.
+     * @param name    Tag name or path of the elements to find.
+     * @param targets Receives the selected elements, in document order.
+     * @return \c true if at least one element was selected.
+     */
+    bool SelectElements(const std::string& name,
+            std::vector<XERCES_CPP_NAMESPACE::DOMNode*>& targets);
     
     /**
      * Uses \c DOMTreeWalker to print the current document to standard out. This
@@ -178,6 +578,12 @@ private:
      */
     void OutputDocument() ;  
     
+    /**
+     * Writes whatever is left in \c output_buffer to \c out and flushes it,
+     *      then empties the buffer.
+     */
+    void FlushOutputBuffer();
+    
     /**
      * Add an individual element to the tree structure. This method is called
      *      after the regular expression from the user has been split into
@@ -195,16 +601,82 @@ private:
      */
     void AddElement(const std::string& parent_name, 
             const std::string& child_name, const std::string& child_content);
+    
+    /**
+     * Appends many children with the same name to an element. The parent is
+     *      looked up, and the child's name converted, only once; a single
+     *      message is printed for each parent instead of one per child, which
+     *      makes building large documents far faster than with AddElement().
+     * @param parent_name Name of the parent, or "root" for the root.
+     * @param child_name  Name of the children.
+     * @param count       Number of children to append. Ignored unless
+     *      \c contents is empty.
+     * @param contents    Content of each child to append, in order. If
+     *      empty, \c count children are appended without content.
+     */
+    void AddElements(const std::string& parent_name, 
+            const std::string& child_name, const std::size_t count,
+            const std::vector<std::string>& contents);
+    
+    /**
+     * Finds the elements that children are to be appended to. \c parent_name
+     *      may be "root" to choose the root, which is why elements named
+     *      "root" can't be parents. An error message is printed if no element
+     *      can be selected.
+     * @param parent_name Name of the parent.
+     * @param parents     Receives the selected elements, in document order.
+     * @return \c true if at least one element was selected.
+     */
+    bool SelectParents(const std::string& parent_name,
+            std::vector<XERCES_CPP_NAMESPACE::DOMNode*>& parents);
         
     /**
      * Attempts to output the current document to a file located at the path   
-     *      specified by <code>filename</code>. This method will print a message
-     *      indicating whether the output operation succeeded or failed.
-     * @param filename Path to the file being output to.
-     * @throw std::runtime_error If the factory methods for the serializer or
-     *      output description return null.
+     *      specified by <code>filename</code>, using \c DocumentWriter. This
+     *      method will print a message indicating whether the output
+     *      operation succeeded or failed, and if it succeeded, how many bytes
+     *      were written and how long it took.
+     * @param filename Path to the file being output to, "-" for standard out
+     *      or "fd:N" for an open file descriptor.
+     * @param options  Serializer settings.
+     */
+    void WriteToFile(const std::string& filename, 
+            const DocumentWriter::Options& options);
+    
+    /**
+     * Copies the current document, then writes the copy on a background
+     *      thread with \c DocumentWriter. Commands can go on being entered
+     *      (and can change the document) while the copy is written; the job
+     *      is followed with the "jobs" and "wait" commands.
+     * @param filename Path to the file being output to, or "fd:N" for an
+     *      open file descriptor. Standard out is not allowed, as the output
+     *      would be mixed up with that of other commands.
+     * @param options  Serializer settings.
+     */
+    void StartBackgroundWrite(const std::string& filename, 
+            const DocumentWriter::Options& options);
+    
+    /**
+     * Waits for a background write to finish, then reports its outcome.
+     * @param job The job to finish. Its outcome can't be retrieved again.
+     */
+    void FinishJob(BackgroundWrite& job);
+    
+    /**
+     * Waits for every background write to finish, reporting each outcome,
+     *      and empties \c jobs. Called before quitting, so that no write is
+     *      cut short.
+     */
+    void WaitForJobs();
+    
+    /**
+     * Prints the message reporting a successful write: its size, speed and,
+     *      if it was compressed, the compression ratio.
+     * @param filename Destination the document was written to.
+     * @param stats    Measurements taken while writing.
      */
-    void WriteToFile(const std::string& filename);
+    void ReportWrite(const std::string& filename, 
+            const DocumentWriter::Stats& stats);
     
     /**
      * Add an individual attribute to an element of the tree structure. This
@@ -223,9 +695,21 @@ private:
             const std::string& attr_name, const std::string& attr_val);
     
     /**
-     * Prints a menu detailing the various commands available for use.
+     * Adds several attributes to an element at once, printing a single
+     *      message for each element rather than one per attribute.
+     * @param parent_name Name of the element.
+     * @param attributes  Key/value pairs of the attributes, in order.
+     */
+    void AddAttributes(const std::string& parent_name, 
+            const std::vector<std::pair<std::string, std::string>>& attributes);
+    
+    /**
+     * Prints a menu detailing the various commands available for use. The
+     *      "help" command takes no arguments; if any are given, the list of
+     *      acceptable commands is printed instead.
+     * @param tokens tokens of the command entered by the user.
      */
-    void ProcessHelpCommand();
+    void ProcessHelpCommand(const CommandGrammar::TokenList& tokens);
     
     /**
      * Given a node name, this method will find any nodes with matching names,
@@ -250,17 +734,152 @@ private:
      */
     void PrintSubTree(const std::string& root_name);
     
+    /**
+     * Keyword table for the command language, shared by all parsers.
+     */
+    const CommandGrammar& grammar;
+    
+    /**
+     * Signature shared by every command handler in the dispatch table.
+     */
+    typedef void (InputParser::*CommandHandler)(
+            const CommandGrammar::TokenList& tokens);
+    
     /**
      * Individual DOM Implementations are represented by a singleton. 
      */
     XERCES_CPP_NAMESPACE::DOMImplementation* impl = nullptr;
     
+    /**
+     * Stream that receives everything the parser prints.
+     */
+    std::ostream& out;
+    
+    /**
+     * Memory for the current document if it was created by the parser (but
+     *      not if it was loaded from a file, as those belong to the global
+     *      memory manager). Declared before \c doc, so that it outlives the
+     *      document. Each document of the workspace has its own arena, so
+     *      that one can be freed without the others.
+     */
+    std::unique_ptr<ArenaMemoryManager> arena { new ArenaMemoryManager() };
+    
     /**
      * The pointer representing the document is owned by a smart pointer that
      *      will automatically call \c release on the document upon destruction.
      */
     DocumentPtr doc = nullptr;
     
+    /**
+     * Index of element names to the elements of \c doc. Kept up to date
+     *      whenever an element is appended to or removed from the document.
+     */
+    NodeIndex index;
+    
+    /**
+     * Name of the current document in the workspace.
+     */
+    std::string document_name = "main";
+    
+    /**
+     * The other documents of the workspace, by name. The implementation,
+     *      the name and path caches and the statistics are shared by every
+     *      document, so that many documents can be processed without
+     *      starting over for each one.
+     */
+    std::map<std::string, WorkspaceDocument> documents;
+    
+    /**
+     * Unicode forms of the element and attribute names used by commands, so
+     *      that repeated names are only transcoded once.
+     */
+    NameCache names;
+    
+    /**
+     * Paths used by commands, compiled once each.
+     */
+    NodePathCache paths;
+    
+    /**
+     * \c true to find elements through \c index, \c false to fall back to
+     *      scanning the document.
+     */
+    bool use_index = true;
+    
+    /**
+     * Number of threads that scan the document when \c use_index is
+     *      \c false. With 1, \c getElementsByTagName is used.
+     */
+    std::size_t scan_threads = 1;
+    
+    /**
+     * \c true when running unattended; see SetBatchMode().
+     */
+    bool batch_mode = false;
+    
+    /**
+     * \c true to answer "yes" to confirmations without prompting.
+     */
+    bool auto_confirm = false;
+    
+    /**
+     * How a name that matches several elements is resolved.
+     */
+    DOMUtil::SelectionPolicy selection_policy = 
+            DOMUtil::SelectionPolicy::Prompt;
+    
+    /**
+     * How much is reported about each command.
+     */
+    Verbosity verbosity = Verbosity::Normal;
+    
+    /**
+     * Stream returned by Message() when quiet. It has no buffer, so anything
+     *      written to it is dropped without even being formatted.
+     */
+    std::ostream discard { nullptr };
+    
+    /**
+     * \c true once the command being run has reported an error.
+     */
+    bool command_failed = false;
+    
+    /**
+     * Number of commands run by the current script.
+     */
+    std::size_t commands_run = 0;
+    
+    /**
+     * Number of commands run by the current script that reported an error.
+     */
+    std::size_t commands_failed = 0;
+    
+    /**
+     * Call counts and latencies of the commands and DOM operations. Only
+     *      updated by the thread that runs the commands, so background
+     *      writes are not included.
+     */
+    CommandStats command_stats;
+    
+    /**
+     * Output of the print command is formatted here, and written out in
+     *      blocks of about 64 KB. The buffer is reused from one command to the
+     *      next.
+     */
+    std::string output_buffer;
+    
+    /**
+     * Background writes that have not been reported yet, in the order they
+     *      were started. Declared last, so that it is destroyed first: the
+     *      destructor of each future waits for its write to finish.
+     */
+    std::vector<BackgroundWrite> jobs;
+    
+    /**
+     * Number given to the next background write.
+     */
+    unsigned next_job_id = 1;
+    
 };
 
 #endif	/* INPUTPARSER_H */
@@ -4,23 +4,55 @@
  * Contact: conor_finegan@student.uml.edu
  * 
  * Created on November 26, 2015, 1:05 PM
+ * 
+ * UPDATE 10/17/26: Short ASCII strings are now narrowed into a buffer inside
+ *                  the object, so the common case never touches the heap.
  */
 
 #include "LocalStr.h"
 
 XERCES_CPP_NAMESPACE_USE
 
+constexpr std::size_t LocalStr::SMALL_CAPACITY;
+
 LocalStr::LocalStr(const XMLCh* const xml_str)
 {
-    // Convert input string from unicode to local system encoding
-    local_form = XMLString::transcode(xml_str);
+    Transcode(xml_str);
 }
 
 LocalStr::~LocalStr() noexcept
 {
-    // De-allocate the local string
+    // De-allocate the local string, unless it's stored in the object
     // If this call fails, the program will call \c std::terminate
-    XMLString::release(&local_form);
+    if (local_form != small_form)
+    {
+        XMLString::release(&local_form);
+    }
+}
+
+void LocalStr::Transcode(const XMLCh* const xml_str)
+{
+    // transcode() would also return null
+    if (!xml_str) { return; }
+    
+    // Fast path: ASCII is the same in Unicode and in the local code page, so
+    //      it can be narrowed one character at a time
+    for (std::size_t i = 0; i < SMALL_CAPACITY; ++ i)
+    {
+        const XMLCh c = xml_str[i];
+        if (c >= 0x80) { break; }
+        
+        small_form[i] = static_cast<char>(c);
+        
+        if (c == 0)
+        {
+            local_form = small_form;
+            return;
+        }
+    }
+    
+    // Convert input string from unicode to local system encoding
+    local_form = XMLString::transcode(xml_str);
 }
 
 const char* LocalStr::get_local_form()
@@ -13,16 +13,19 @@
 #ifndef LOCALSTR_H
 #define	LOCALSTR_H
 
+#include <cstddef>
 #include <iostream>
 #include <xercesc/util/XMLString.hpp>
 
 /**
  * Wrapper class for system-local C-string that will, upon destruction,
  *      automatically deallocate its member string using the DLL-safe 
- *      \c XMLString::release method.
+ *      \c XMLString::release method. Strings of fewer than \c SMALL_CAPACITY
+ *      ASCII characters are stored inside the object instead, and are never
+ *      allocated or released.
  * @param xml_str \c Unicode string of type \c XMLCh* to be transcoded and stored.
  * @author Conor Finegan<br>conor_finegan@student.uml.edu
- * @version 1.0
+ * @version 1.1
  */
 class LocalStr final
 {
@@ -83,12 +86,30 @@ public:
      */
     friend std::ostream& operator<<(std::ostream& out, const LocalStr& lstr);
     
+    /**
+     * Capacity of the internal buffer, including the null terminator.
+     */
+    static constexpr std::size_t SMALL_CAPACITY = 64;
+    
 private:
 
     /**
-     * Pointer to the system-local interpretation of the string.
+     * Stores the local form of \c xml_str in \c small_form if it is short
+     *      enough and entirely ASCII, otherwise transcodes it onto the heap.
+     * @param xml_str XML-String to encode. May be null.
+     */
+    void Transcode(const XMLCh* const xml_str);
+
+    /**
+     * Pointer to the system-local interpretation of the string. Points
+     *      either to \c small_form or to memory owned by Xerces-c.
      */
     char* local_form = nullptr;
+    
+    /**
+     * Storage for short strings.
+     */
+    char small_form[SMALL_CAPACITY];
 };
 
 /**
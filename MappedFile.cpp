@@ -0,0 +1,101 @@
+/*
+ * File:    MappedFile.cpp
+ * Author:  Conor Finegan
+ * Contact: conor_finegan@student.uml.edu
+ *
+ * Created on October 17, 2026
+ */
+
+#include "MappedFile.h"
+
+#include <limits>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace std;
+
+MappedFile::MappedFile(const std::string& filename, const bool map)
+{
+    struct stat info;
+    
+    if (stat(filename.c_str(), &info) != 0)
+    {
+        throw std::runtime_error("Could not open the file: \"" + filename 
+                + "\"");
+    }
+    
+    // Pipes and devices are left for the caller to open, exactly once:
+    //      opening a pipe here would connect to its writer, and closing it
+    //      again could leave the writer without a reader
+    if (!S_ISREG(info.st_mode))
+    {
+        return;
+    }
+    
+    const int fd = open(filename.c_str(), O_RDONLY);
+    
+    if (fd < 0)
+    {
+        throw std::runtime_error("Could not open the file: \"" + filename 
+                + "\"");
+    }
+    
+    // Only regular files have a fixed size that can be mapped. An empty file
+    //      can't be mapped either, but there's nothing to gain from it anyway.
+    if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode))
+    {
+        file_size = static_cast<uint64_t>(info.st_size);
+        
+        if (map && file_size > 0 && 
+                file_size <= numeric_limits<size_t>::max())
+        {
+            void* mapping = mmap(nullptr, static_cast<size_t>(file_size), 
+                    PROT_READ, MAP_PRIVATE, fd, 0);
+            
+            // A failed mapping isn't an error; the caller falls back to
+            //      reading the file as a stream
+            if (mapping != MAP_FAILED)
+            {
+                data = mapping;
+                size = static_cast<size_t>(file_size);
+                
+                // The parser reads the file front to back exactly once
+                madvise(data, size, MADV_SEQUENTIAL);
+            }
+        }
+    }
+    
+    // The mapping stays valid after the descriptor is closed
+    close(fd);
+}
+
+MappedFile::~MappedFile()
+{
+    if (data)
+    {
+        munmap(data, size);
+    }
+}
+
+bool MappedFile::IsMapped() const
+{
+    return data != nullptr;
+}
+
+const char* MappedFile::Data() const
+{
+    return static_cast<const char*>(data);
+}
+
+std::size_t MappedFile::Size() const
+{
+    return size;
+}
+
+std::uint64_t MappedFile::FileSize() const
+{
+    return file_size;
+}
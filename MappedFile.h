@@ -0,0 +1,100 @@
+/*
+ * File:    MappedFile.h
+ * Author:  Conor Finegan
+ * Contact: conor_finegan@student.uml.edu
+ *
+ * Created on October 17, 2026
+ */
+
+#ifndef MAPPEDFILE_H
+#define	MAPPEDFILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+/**
+ * The \c MappedFile class maps a file read-only into memory for as long as
+ *      the object lives, so that its contents can be read straight from the
+ *      page cache instead of being copied through a read buffer. Only
+ *      regular files can be mapped; for anything else (pipes, devices) the
+ *      object is still constructed, but IsMapped() returns \c false and the
+ *      caller is expected to read the file as a stream instead.
+ * @author Conor Finegan<br>conor_finegan@student.uml.edu
+ * @version 1.0
+ */
+class MappedFile final
+{
+public:
+    
+    /**
+     * Opens and, if possible, maps the file at \c filename. Files that
+     *      aren't regular files are not opened at all, so that a pipe is
+     *      only opened by the caller that reads it.
+     * @param filename Path to the file to map.
+     * @param map      \c false to only open and measure the file.
+     * @throw std::runtime_error If the file doesn't exist, or is a regular
+     *      file that can't be opened.
+     */
+    explicit MappedFile(const std::string& filename, const bool map = true);
+    
+    /**
+     * Unmaps the file, if it was mapped.
+     */
+    ~MappedFile();
+    
+    /**
+     * Copying is prohibited, as each object owns its mapping.
+     */
+    MappedFile(const MappedFile&) = delete;
+    
+    /**
+     * Copying is prohibited, as each object owns its mapping.
+     */
+    MappedFile& operator=(const MappedFile&) = delete;
+    
+    /**
+     * @return \c true if the contents of the file are available through
+     *      Data().
+     */
+    bool IsMapped() const;
+    
+    /**
+     * @return The start of the mapped contents, or null if the file is not
+     *      mapped.
+     */
+    const char* Data() const;
+    
+    /**
+     * @return The size of the mapped contents in bytes, or zero if the file
+     *      is not mapped.
+     */
+    std::size_t Size() const;
+    
+    /**
+     * @return The size of the file in bytes if it is a regular file (whether
+     *      or not it could be mapped), otherwise zero.
+     */
+    std::uint64_t FileSize() const;
+    
+private:
+    
+    /**
+     * Start of the mapping, or null if the file is not mapped.
+     */
+    void* data = nullptr;
+    
+    /**
+     * Length of the mapping in bytes.
+     */
+    std::size_t size = 0;
+    
+    /**
+     * Size of the file as reported by the file system.
+     */
+    std::uint64_t file_size = 0;
+};
+
+#endif	/* MAPPEDFILE_H */
+
@@ -0,0 +1,87 @@
+/*
+ * File:    NameCache.cpp
+ * Author:  Conor Finegan
+ * Contact: conor_finegan@student.uml.edu
+ *
+ * Created on October 17, 2026
+ */
+
+#include "NameCache.h"
+
+using namespace std;
+XERCES_CPP_NAMESPACE_USE
+
+constexpr std::size_t NameCache::MAX_NAMES;
+
+NameCache::~NameCache() noexcept
+{
+    Clear();
+}
+
+const XMLCh* NameCache::Get(const std::string& name)
+{
+    auto entry = names.find(name);
+    
+    if (entry != names.end())
+    {
+        ++ hits;
+        return entry->second;
+    }
+    
+    ++ misses;
+    
+    // Transcode the name once; the cache owns the result from here on
+    XMLCh* unicode_form = XMLString::transcode(name.c_str());
+    
+    try
+    {
+        names.emplace(name, unicode_form);
+    }
+    catch (...)
+    {
+        XMLString::release(&unicode_form);
+        throw;
+    }
+    
+    return unicode_form;
+}
+
+void NameCache::Trim()
+{
+    if (names.size() > MAX_NAMES)
+    {
+        ReleaseNames();
+    }
+}
+
+void NameCache::Clear()
+{
+    ReleaseNames();
+    hits = 0;
+    misses = 0;
+}
+
+std::size_t NameCache::Size() const
+{
+    return names.size();
+}
+
+std::uint64_t NameCache::Hits() const
+{
+    return hits;
+}
+
+std::uint64_t NameCache::Misses() const
+{
+    return misses;
+}
+
+void NameCache::ReleaseNames()
+{
+    for (auto& entry : names)
+    {
+        XMLString::release(&entry.second);
+    }
+    
+    names.clear();
+}
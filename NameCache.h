@@ -0,0 +1,127 @@
+/*
+ * File:    NameCache.h
+ * Author:  Conor Finegan
+ * Contact: conor_finegan@student.uml.edu
+ *
+ * Created on October 17, 2026
+ */
+
+#ifndef NAMECACHE_H
+#define	NAMECACHE_H
+
+#include <xercesc/util/XMLString.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+/**
+ * The \c NameCache class interns element and attribute names: each name is
+ *      transcoded to Unicode the first time it is seen, and the same string
+ *      is handed out from then on. Scripts repeat a small set of names many
+ *      times, so most lookups are a hash lookup rather than an allocation
+ *      and a transcode. The strings belong to the cache rather than to any
+ *      document, so they stay valid when the document is replaced. The
+ *      cache is emptied by Trim() once it holds more than \c MAX_NAMES
+ *      names, so that a script that makes up a new name for every element
+ *      doesn't keep a copy of each of them forever.
+ * @author Conor Finegan<br>conor_finegan@student.uml.edu
+ * @version 1.0
+ */
+class NameCache final
+{
+public:
+    
+    /**
+     * Highest number of names kept. Trim() empties a cache that holds more.
+     */
+    static constexpr std::size_t MAX_NAMES = 4096;
+    
+    /**
+     * Constructs an empty cache.
+     */
+    NameCache() = default;
+    
+    /**
+     * Disabled copy constructor \n
+     * Copying is disabled because the cache owns its strings.
+     */
+    NameCache(const NameCache&) = delete;
+    
+    /**
+     * Disabled copy-assignment operator \n
+     * Copying is disabled because the cache owns its strings.
+     */
+    void operator=(const NameCache&) = delete;
+    
+    /**
+     * Destructor \n
+     * Releases every cached string.
+     */
+    ~NameCache() noexcept;
+    
+    /**
+     * Looks up the Unicode form of a name, transcoding and caching it if it
+     *      hasn't been seen before.
+     * @param name Name in system-local form.
+     * @return The Unicode form of \c name. Valid until the cache is cleared,
+     *      trimmed or destroyed.
+     */
+    const XMLCh* Get(const std::string& name);
+    
+    /**
+     * Releases every cached string if there are more than \c MAX_NAMES of
+     *      them. The counters are kept. Get() never empties the cache itself,
+     *      since a caller may hold several of its strings at once; this is
+     *      called between commands instead, when none are in use.
+     */
+    void Trim();
+    
+    /**
+     * Releases every cached string and resets the counters. Strings returned
+     *      by Get() before this call are no longer valid.
+     */
+    void Clear();
+    
+    /**
+     * @return The number of names in the cache.
+     */
+    std::size_t Size() const;
+    
+    /**
+     * @return The number of calls to Get() that found their name cached.
+     */
+    std::uint64_t Hits() const;
+    
+    /**
+     * @return The number of calls to Get() that had to transcode their name.
+     */
+    std::uint64_t Misses() const;
+    
+private:
+    
+    /**
+     * Releases every cached string, leaving the counters as they are.
+     */
+    void ReleaseNames();
+    
+    /**
+     * Cached names, mapped to their Unicode forms. The Unicode strings are
+     *      owned by the cache and released with \c XMLString::release.
+     */
+    std::unordered_map<std::string, XMLCh*> names;
+    
+    /**
+     * Number of lookups that found their name cached.
+     */
+    std::uint64_t hits = 0;
+    
+    /**
+     * Number of lookups that had to transcode their name.
+     */
+    std::uint64_t misses = 0;
+};
+
+#endif	/* NAMECACHE_H */
+
@@ -0,0 +1,143 @@
+/*
+ * File:    NodeIndex.cpp
+ * Author:  Conor Finegan
+ * Contact: conor_finegan@student.uml.edu
+ *
+ * Created on October 17, 2026
+ */
+
+#include "NodeIndex.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+using namespace std;
+XERCES_CPP_NAMESPACE_USE
+
+template <typename Visitor>
+void NodeIndex::ForEachElement(DOMNode* root, Visitor visit)
+{
+    DOMNode* node = root;
+
+    while (node)
+    {
+        if (node->getNodeType() == DOMNode::ELEMENT_NODE)
+        {
+            visit(node);
+        }
+
+        // Descend first...
+        DOMNode* next = node->getFirstChild();
+
+        // ...otherwise move on to the next sibling of the closest ancestor
+        //      that has one, without ever leaving the subtree under root
+        while (!next && node != root)
+        {
+            next = node->getNextSibling();
+
+            if (!next) { node = node->getParentNode(); }
+        }
+
+        node = next;
+    }
+}
+
+void NodeIndex::Clear()
+{
+    buckets.clear();
+}
+
+void NodeIndex::Rebuild(DOMNode* root)
+{
+    Clear();
+
+    if (root)
+    {
+        Insert(root);
+    }
+}
+
+void NodeIndex::Insert(DOMNode* node, const std::string& name)
+{
+    Bucket& bucket = buckets[name];
+
+    // The bucket stays in document order as long as each new node follows
+    //      the last one. A node appended under the last node, or after it
+    //      under the same parent, always does; anything else needs the
+    //      (more expensive) general comparison.
+    if (bucket.ordered && !bucket.nodes.empty())
+    {
+        DOMNode* last = bucket.nodes.back();
+        DOMNode* parent = node->getParentNode();
+
+        if (last != parent && last->getParentNode() != parent)
+        {
+            bucket.ordered = (last->compareDocumentPosition(node) &
+                    DOMNode::DOCUMENT_POSITION_FOLLOWING) != 0;
+        }
+    }
+
+    bucket.nodes.push_back(node);
+}
+
+void NodeIndex::Insert(DOMNode* node)
+{
+    ForEachElement(node, [this](DOMNode* element)
+    {
+        Insert(element, LSTR(element->getNodeName()));
+    });
+}
+
+void NodeIndex::Remove(DOMNode* node)
+{
+    // Gather the doomed nodes by name first, so that each bucket only has
+    //      to be compacted once no matter how many of its nodes are removed
+    unordered_map<string, unordered_set<DOMNode*>> doomed;
+
+    ForEachElement(node, [&doomed](DOMNode* element)
+    {
+        doomed[LSTR(element->getNodeName())].insert(element);
+    });
+
+    for (const auto& entry : doomed)
+    {
+        auto bucket = buckets.find(entry.first);
+        if (bucket == buckets.end()) { continue; }
+
+        vector<DOMNode*>& nodes = bucket->second.nodes;
+        const unordered_set<DOMNode*>& removed = entry.second;
+
+        nodes.erase(remove_if(nodes.begin(), nodes.end(),
+                [&removed](DOMNode* n) { return removed.count(n) != 0; }),
+                nodes.end());
+
+        // Don't keep empty buckets around for names that no longer exist
+        if (nodes.empty()) { buckets.erase(bucket); }
+    }
+}
+
+const std::vector<DOMNode*>& NodeIndex::Find(const std::string& name) const
+{
+    static const vector<DOMNode*> none;
+    auto bucket = buckets.find(name);
+
+    if (bucket == buckets.end())
+    {
+        return none;
+    }
+
+    // Restore document order if the bucket was appended to out of order
+    if (!bucket->second.ordered)
+    {
+        sort(bucket->second.nodes.begin(), bucket->second.nodes.end(),
+                [](DOMNode* a, DOMNode* b)
+                {
+                    return (a->compareDocumentPosition(b) &
+                            DOMNode::DOCUMENT_POSITION_FOLLOWING) != 0;
+                });
+
+        bucket->second.ordered = true;
+    }
+
+    return bucket->second.nodes;
+}
@@ -0,0 +1,117 @@
+/*
+ * File:    NodeIndex.h
+ * Author:  Conor Finegan
+ * Contact: conor_finegan@student.uml.edu
+ *
+ * Created on October 17, 2026
+ */
+
+#ifndef NODEINDEX_H
+#define	NODEINDEX_H
+
+#include "LocalStr.h"
+
+#include <xercesc/dom/DOM.hpp>
+#include <xercesc/dom/DOMNode.hpp>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * The \c NodeIndex class maps element names to the elements of a document
+ *      that carry them, so that finding an element by name is a hash lookup
+ *      rather than a walk over the whole document (which is what
+ *      \c DOMDocument::getElementsByTagName does). The index does not observe
+ *      the document; it must be told about every element appended to, or
+ *      removed from, the tree through Insert() and Remove().
+ * @author Conor Finegan<br>conor_finegan@student.uml.edu
+ * @version 1.0
+ */
+class NodeIndex final
+{
+public:
+
+    /**
+     * Removes every entry from the index.
+     */
+    void Clear();
+
+    /**
+     * Discards the current contents of the index and registers \c root and
+     *      every element beneath it.
+     * @param root Root of the tree to index. May be null, in which case the
+     *      index is simply cleared.
+     */
+    void Rebuild(XERCES_CPP_NAMESPACE::DOMNode* root);
+
+    /**
+     * Registers a single element that has just been appended to the
+     *      document, using a name the caller already has in local form.
+     * @param node Element that was appended. Must not have element children
+     *      that are not yet indexed.
+     * @param name Tag name of \c node.
+     */
+    void Insert(XERCES_CPP_NAMESPACE::DOMNode* node, const std::string& name);
+
+    /**
+     * Registers \c node and every element beneath it.
+     * @param node Root of the subtree that was appended to the document.
+     */
+    void Insert(XERCES_CPP_NAMESPACE::DOMNode* node);
+
+    /**
+     * Unregisters \c node and every element beneath it. This must be called
+     *      before the subtree is released, while its nodes are still valid.
+     * @param node Root of the subtree being removed from the document.
+     */
+    void Remove(XERCES_CPP_NAMESPACE::DOMNode* node);
+
+    /**
+     * Finds every indexed element with the given name.
+     * @param name Tag name to look up.
+     * @return The matching elements, in document order (the same order as
+     *      \c getElementsByTagName would return them). The list belongs to
+     *      the index, so it is not copied; it is only valid until the index
+     *      is next changed.
+     */
+    const std::vector<XERCES_CPP_NAMESPACE::DOMNode*>& Find(
+            const std::string& name) const;
+
+private:
+
+    /**
+     * All of the elements sharing one name.
+     */
+    struct Bucket
+    {
+        /** Elements with this name, in insertion order. */
+        std::vector<XERCES_CPP_NAMESPACE::DOMNode*> nodes;
+
+        /**
+         * \c true while \c nodes is known to be in document order. Appending
+         *      to the end of the document keeps a bucket ordered; anything
+         *      else defers a sort to the next Find().
+         */
+        bool ordered = true;
+    };
+
+    /**
+     * Calls \c visit for \c root and each element beneath it, in document
+     *      order. Iterative, so that deep documents can't overflow the stack.
+     * @param root  Root of the subtree to visit.
+     * @param visit Called with each element.
+     */
+    template <typename Visitor>
+    static void ForEachElement(XERCES_CPP_NAMESPACE::DOMNode* root,
+            Visitor visit);
+
+    /**
+     * Index of element names to elements. Mutable because Find() sorts
+     *      buckets into document order on demand.
+     */
+    mutable std::unordered_map<std::string, Bucket> buckets;
+};
+
+#endif	/* NODEINDEX_H */
+
@@ -0,0 +1,384 @@
+/*
+ * File:    NodePath.cpp
+ * Author:  Conor Finegan
+ * Contact: conor_finegan@student.uml.edu
+ *
+ * Created on October 17, 2026
+ */
+
+#include "NodePath.h"
+#include "XStr.h"
+
+#include <algorithm>
+#include <cctype>
+#include <stdexcept>
+
+using namespace std;
+XERCES_CPP_NAMESPACE_USE
+
+constexpr std::size_t NodePathCache::MAX_PATHS;
+
+bool NodePath::IsPath(const std::string& text)
+{
+    return text == "*" || (!text.empty() &&
+            (text[0] == '/' || text.find('[') != string::npos));
+}
+
+NodePath::NodePath(const std::string& text) : text(text)
+{
+    size_t pos = 0;
+
+    do
+    {
+        Step step;
+
+        // A path that doesn't start with '/' is searched for anywhere
+        if (pos == 0 && (text.empty() || text[0] != '/'))
+        {
+            step.descendants = true;
+        }
+
+        else if (pos < text.size() && text[pos] == '/')
+        {
+            ++ pos;
+
+            if (pos < text.size() && text[pos] == '/')
+            {
+                step.descendants = true;
+                ++ pos;
+            }
+        }
+
+        else
+        {
+            Fail("'/', '[' or the end of the path", pos);
+        }
+
+        if (pos < text.size() && text[pos] == '*')
+        {
+            step.name = "*";
+            ++ pos;
+        }
+
+        else
+        {
+            step.name = ReadName(pos);
+            if (step.name.empty()) { Fail("an element name or '*'", pos); }
+
+            step.tag = ToUnicode(step.name);
+        }
+
+        while (pos < text.size() && text[pos] == '[')
+        {
+            ++ pos;
+            step.predicates.push_back(ReadPredicate(pos));
+        }
+
+        steps.push_back(std::move(step));
+    }
+    while (pos < text.size());
+}
+
+const std::string& NodePath::Text() const
+{
+    return text;
+}
+
+std::vector<DOMNode*> NodePath::Evaluate(DOMDocument* doc,
+        const Lookup& lookup) const
+{
+    // Elements matched by the steps so far, always in document order
+    vector<DOMNode*> context(1, doc);
+    vector<DOMNode*> candidates;
+
+    for (size_t i = 0; i < steps.size() && !context.empty(); ++ i)
+    {
+        const Step& step = steps[i];
+        candidates.clear();
+
+        // A leading "//name" is every element with that name, which the
+        //      lookup can usually answer without walking the document
+        if (i == 0 && step.descendants && !step.tag.empty() && lookup)
+        {
+            candidates = lookup(step.name);
+        }
+
+        else
+        {
+            // Outermost context element whose subtree has been visited. As
+            //      the context is in document order, the elements inside it
+            //      follow it directly.
+            const DOMNode* covered = nullptr;
+            bool nested = false;
+
+            for (DOMNode* node : context)
+            {
+                if (covered && Contains(covered, node))
+                {
+                    // Its descendants were visited with those of "covered"
+                    if (step.descendants) { continue; }
+
+                    // Its children come after those of "covered" below, so
+                    //      they may be out of document order
+                    nested = true;
+                }
+
+                else
+                {
+                    covered = node;
+                }
+
+                if (!step.descendants)
+                {
+                    for (DOMNode* child = node->getFirstChild(); child;
+                            child = child->getNextSibling())
+                    {
+                        if (MatchesName(child, step))
+                        {
+                            candidates.push_back(child);
+                        }
+                    }
+
+                    continue;
+                }
+
+                // Visit the subtree in document order, without recursion
+                DOMNode* next = node->getFirstChild();
+
+                while (next)
+                {
+                    if (MatchesName(next, step)) { candidates.push_back(next); }
+
+                    if (next->getFirstChild())
+                    {
+                        next = next->getFirstChild();
+                        continue;
+                    }
+
+                    while (next != node && !next->getNextSibling())
+                    {
+                        next = next->getParentNode();
+                    }
+
+                    next = (next == node) ? nullptr : next->getNextSibling();
+                }
+            }
+
+            if (nested)
+            {
+                sort(candidates.begin(), candidates.end(),
+                        [](const DOMNode* a, const DOMNode* b)
+                {
+                    return (a->compareDocumentPosition(b) &
+                            DOMNode::DOCUMENT_POSITION_FOLLOWING) != 0;
+                });
+            }
+        }
+
+        Filter(step, candidates);
+        context.swap(candidates);
+    }
+
+    return context;
+}
+
+void NodePath::Fail(const std::string& expected, const std::size_t pos) const
+{
+    throw runtime_error("Invalid path \"" + text + "\": expected " +
+            expected + " at character " + to_string(pos + 1) + ".");
+}
+
+std::string NodePath::ReadName(std::size_t& pos) const
+{
+    const size_t start = pos;
+
+    while (pos < text.size())
+    {
+        const unsigned char c = text[pos];
+        if (!isalnum(c) && c != '_' && c != '-' && c != '.' && c != ':')
+        {
+            break;
+        }
+
+        ++ pos;
+    }
+
+    return text.substr(start, pos - start);
+}
+
+NodePath::Predicate NodePath::ReadPredicate(std::size_t& pos) const
+{
+    Predicate predicate;
+
+    if (pos < text.size() && isdigit(static_cast<unsigned char>(text[pos])))
+    {
+        const size_t start = pos;
+        size_t position = 0;
+
+        while (pos < text.size() &&
+                isdigit(static_cast<unsigned char>(text[pos])))
+        {
+            position = position * 10 + (text[pos] - '0');
+            if (position > 1000000000) { Fail("a smaller position", start); }
+
+            ++ pos;
+        }
+
+        if (position == 0) { Fail("a position of 1 or more", start); }
+
+        predicate.kind = Predicate::Kind::Position;
+        predicate.position = position;
+    }
+
+    else if (pos < text.size() && text[pos] == '@')
+    {
+        ++ pos;
+
+        const string attribute = ReadName(pos);
+        if (attribute.empty()) { Fail("an attribute name", pos); }
+
+        predicate.kind = Predicate::Kind::HasAttribute;
+        predicate.attribute = ToUnicode(attribute);
+
+        if (pos < text.size() && text[pos] == '=')
+        {
+            ++ pos;
+
+            // The value may be quoted, or run up to the closing bracket
+            const bool quoted = pos < text.size() &&
+                    (text[pos] == '\'' || text[pos] == '"');
+            const char end = quoted ? text[pos] : ']';
+            if (quoted) { ++ pos; }
+
+            const size_t close = text.find(end, pos);
+            if (close == string::npos)
+            {
+                Fail(string("a closing ") + end, text.size());
+            }
+
+            predicate.kind = Predicate::Kind::AttributeEquals;
+            predicate.value = ToUnicode(text.substr(pos, close - pos));
+            pos = quoted ? close + 1 : close;
+        }
+    }
+
+    else
+    {
+        Fail("a position or '@'", pos);
+    }
+
+    if (pos >= text.size() || text[pos] != ']') { Fail("']'", pos); }
+    ++ pos;
+
+    return predicate;
+}
+
+NodePath::UnicodeName NodePath::ToUnicode(const std::string& name)
+{
+    XStr unicode(name);
+    const XMLCh* const unicode_form = unicode.get_unicode_form();
+
+    return UnicodeName(unicode_form,
+            unicode_form + XMLString::stringLen(unicode_form) + 1);
+}
+
+bool NodePath::MatchesName(const DOMNode* node, const Step& step)
+{
+    return node->getNodeType() == DOMNode::ELEMENT_NODE &&
+            (step.tag.empty() ||
+            XMLString::equals(node->getNodeName(), step.tag.data()));
+}
+
+void NodePath::Filter(const Step& step, std::vector<DOMNode*>& candidates)
+{
+    for (const Predicate& predicate : step.predicates)
+    {
+        // Positions are counted separately under each parent
+        unordered_map<const DOMNode*, size_t> seen;
+        size_t kept = 0;
+
+        for (DOMNode* node : candidates)
+        {
+            bool keep = false;
+
+            if (predicate.kind == Predicate::Kind::Position)
+            {
+                keep = ++ seen[node->getParentNode()] == predicate.position;
+            }
+
+            else
+            {
+                const DOMAttr* const attribute = static_cast<DOMElement*>(
+                        node)->getAttributeNode(predicate.attribute.data());
+
+                keep = attribute &&
+                        (predicate.kind == Predicate::Kind::HasAttribute ||
+                        XMLString::equals(attribute->getValue(),
+                        predicate.value.data()));
+            }
+
+            if (keep) { candidates[kept ++] = node; }
+        }
+
+        candidates.resize(kept);
+    }
+}
+
+bool NodePath::Contains(const DOMNode* ancestor, const DOMNode* node)
+{
+    for (const DOMNode* parent = node->getParentNode(); parent;
+            parent = parent->getParentNode())
+    {
+        if (parent == ancestor) { return true; }
+    }
+
+    return false;
+}
+
+const NodePath& NodePathCache::Get(const std::string& text)
+{
+    auto entry = paths.find(text);
+
+    if (entry != paths.end())
+    {
+        ++ hits;
+        return *entry->second;
+    }
+
+    ++ misses;
+
+    // Compile before touching the cache, so that a bad path changes nothing
+    unique_ptr<NodePath> path(new NodePath(text));
+
+    if (paths.size() >= MAX_PATHS)
+    {
+        paths.clear();
+    }
+
+    const NodePath& compiled = *path;
+    paths.emplace(text, std::move(path));
+
+    return compiled;
+}
+
+void NodePathCache::Clear()
+{
+    paths.clear();
+    hits = 0;
+    misses = 0;
+}
+
+std::size_t NodePathCache::Size() const
+{
+    return paths.size();
+}
+
+std::uint64_t NodePathCache::Hits() const
+{
+    return hits;
+}
+
+std::uint64_t NodePathCache::Misses() const
+{
+    return misses;
+}
@@ -0,0 +1,289 @@
+/*
+ * File:    NodePath.h
+ * Author:  Conor Finegan
+ * Contact: conor_finegan@student.uml.edu
+ *
+ * Created on October 17, 2026
+ */
+
+#ifndef NODEPATH_H
+#define	NODEPATH_H
+
+#include <xercesc/dom/DOM.hpp>
+#include <xercesc/dom/DOMNode.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * The \c NodePath class is a compiled path query, a small subset of XPath
+ *      that addresses elements by where they are rather than only by name:
+ *      <ul>
+ *      <li>"/cats/banshee/age": the "age" children of the "banshee" children
+ *          of the root element "cats".</li>
+ *      <li>"//age" or "age[...]": "age" elements anywhere in the document.
+ *          A path that does not start with '/' is searched for anywhere,
+ *          like a bare name.</li>
+ *      <li>"*" matches an element of any name.</li>
+ *      <li>"[2]" keeps the second of the matching children of each parent
+ *          (counting from 1).</li>
+ *      <li>"[@color]" keeps the elements that have a "color" attribute, and
+ *          "[@color=red]" (or "[@color='red']") those where it is "red".</li>
+ *      </ul>
+ *      Predicates are applied in order, so "age[@unit][2]" is the second of
+ *      the "age" elements that have a "unit". Paths can't contain spaces,
+ *      since commands are split at white-space.
+ *
+ *      The text is compiled once into a list of steps. Evaluating them only
+ *      visits the children of the elements matched by the previous step, or
+ *      their subtrees for a "//" step, rather than the whole document; a
+ *      leading "//name" step is answered by a lookup function, typically the
+ *      name index.
+ * @author Conor Finegan<br>conor_finegan@student.uml.edu
+ * @version 1.0
+ */
+class NodePath final
+{
+public:
+
+    /**
+     * Finds every element of the document with a given name, in document
+     *      order.
+     */
+    typedef std::function<std::vector<XERCES_CPP_NAMESPACE::DOMNode*>(
+            const std::string&)> Lookup;
+
+    /**
+     * Checks whether a name given to a command is a path rather than a bare
+     *      element name, i.e. whether it starts with '/', contains a
+     *      predicate, or is a lone "*" (a one-step path matching every
+     *      element).
+     * @param text Name given to the command.
+     * @return \c true if \c text should be compiled as a path.
+     */
+    static bool IsPath(const std::string& text);
+
+    /**
+     * Compiles a path.
+     * @param text The path.
+     * @throws std::runtime_error if \c text is not a valid path. The message
+     *      says what was expected, and where.
+     */
+    explicit NodePath(const std::string& text);
+
+    /**
+     * @return The text the path was compiled from.
+     */
+    const std::string& Text() const;
+
+    /**
+     * Finds the elements addressed by the path.
+     * @param doc    Document to search.
+     * @param lookup Used to answer a leading "//name" step. May be empty, in
+     *      which case the whole document is walked.
+     * @return The matching elements. Each element is listed once, and an
+     *      element always comes before the elements inside it.
+     */
+    std::vector<XERCES_CPP_NAMESPACE::DOMNode*> Evaluate(
+            XERCES_CPP_NAMESPACE::DOMDocument* doc,
+            const Lookup& lookup) const;
+
+private:
+
+    /**
+     * Null-terminated Unicode string owned by a step.
+     */
+    typedef std::vector<XMLCh> UnicodeName;
+
+    /**
+     * A filter in square brackets.
+     */
+    struct Predicate
+    {
+        /** What the predicate tests. */
+        enum class Kind
+        {
+            /** Position among the matching children of the same parent. */
+            Position,
+
+            /** Presence of an attribute. */
+            HasAttribute,
+
+            /** Value of an attribute. */
+            AttributeEquals
+        };
+
+        Kind kind = Kind::Position;
+
+        /** Position to keep, counting from 1, for \c Kind::Position. */
+        std::size_t position = 0;
+
+        /** Name of the attribute tested. */
+        UnicodeName attribute;
+
+        /** Value the attribute must have, for \c Kind::AttributeEquals. */
+        UnicodeName value;
+    };
+
+    /**
+     * One level of the path, between two slashes.
+     */
+    struct Step
+    {
+        /**
+         * \c true for a "//" step, which matches descendants at any depth
+         *      rather than only children.
+         */
+        bool descendants = false;
+
+        /** Name in local form, or "*" for any element. */
+        std::string name;
+
+        /** Unicode form of \c name; empty for "*". */
+        UnicodeName tag;
+
+        /** Filters applied to the elements that match the name. */
+        std::vector<Predicate> predicates;
+    };
+
+    /**
+     * Reports a syntax error.
+     * @param expected What should have been found.
+     * @param pos      Where in the text it should have been found.
+     * @throws std::runtime_error always.
+     */
+    [[noreturn]] void Fail(const std::string& expected,
+            const std::size_t pos) const;
+
+    /**
+     * Reads a name (word characters, '-', '.' and ':') from the text.
+     * @param pos Where the name starts; advanced past it.
+     * @return The name, which is empty if there is none at \c pos.
+     */
+    std::string ReadName(std::size_t& pos) const;
+
+    /**
+     * Reads a predicate, from just after its '['.
+     * @param pos Where the predicate starts; advanced past its ']'.
+     * @return The compiled predicate.
+     */
+    Predicate ReadPredicate(std::size_t& pos) const;
+
+    /**
+     * Converts a name to the form stored in the steps.
+     * @param name Name in local form.
+     * @return The Unicode form, null-terminated.
+     */
+    static UnicodeName ToUnicode(const std::string& name);
+
+    /**
+     * Checks whether an element matches the name of a step.
+     * @param node Node to check.
+     * @param step Step to match.
+     * @return \c true if \c node is an element with the step's name.
+     */
+    static bool MatchesName(const XERCES_CPP_NAMESPACE::DOMNode* node,
+            const Step& step);
+
+    /**
+     * Removes the candidates of a step that fail its predicates.
+     * @param step       The step.
+     * @param candidates The elements that match the step's name; those that
+     *      fail a predicate are removed.
+     */
+    static void Filter(const Step& step,
+            std::vector<XERCES_CPP_NAMESPACE::DOMNode*>& candidates);
+
+    /**
+     * Checks whether one node is inside another.
+     * @param ancestor The outer node.
+     * @param node     The inner node.
+     * @return \c true if \c node is a descendant of \c ancestor.
+     */
+    static bool Contains(const XERCES_CPP_NAMESPACE::DOMNode* ancestor,
+            const XERCES_CPP_NAMESPACE::DOMNode* node);
+
+    /**
+     * The text the path was compiled from.
+     */
+    const std::string text;
+
+    /**
+     * The compiled steps, from the root down.
+     */
+    std::vector<Step> steps;
+};
+
+/**
+ * The \c NodePathCache class keeps the paths that have been compiled, keyed
+ *      by their text, so that a script that addresses the same path on many
+ *      lines only compiles it once. Paths don't refer to any document, so
+ *      they stay valid when the document is replaced.
+ * @author Conor Finegan<br>conor_finegan@student.uml.edu
+ * @version 1.0
+ */
+class NodePathCache final
+{
+public:
+
+    /**
+     * Highest number of paths kept. When the cache is full, it is emptied
+     *      before the next path is added.
+     */
+    static constexpr std::size_t MAX_PATHS = 1024;
+
+    /**
+     * Looks up a compiled path, compiling and caching it if it hasn't been
+     *      seen before. Paths that don't compile are not cached.
+     * @param text The path.
+     * @return The compiled path. Valid until the cache is cleared or
+     *      destroyed, or until a later call empties a full cache.
+     * @throws std::runtime_error if \c text is not a valid path.
+     */
+    const NodePath& Get(const std::string& text);
+
+    /**
+     * Discards every compiled path and resets the counters.
+     */
+    void Clear();
+
+    /**
+     * @return The number of paths in the cache.
+     */
+    std::size_t Size() const;
+
+    /**
+     * @return The number of calls to Get() that found their path compiled.
+     */
+    std::uint64_t Hits() const;
+
+    /**
+     * @return The number of calls to Get() that had to compile their path.
+     */
+    std::uint64_t Misses() const;
+
+private:
+
+    /**
+     * Compiled paths, keyed by their text.
+     */
+    std::unordered_map<std::string, std::unique_ptr<NodePath>> paths;
+
+    /**
+     * Number of lookups that found their path compiled.
+     */
+    std::uint64_t hits = 0;
+
+    /**
+     * Number of lookups that had to compile their path.
+     */
+    std::uint64_t misses = 0;
+};
+
+#endif	/* NODEPATH_H */
+
@@ -0,0 +1,400 @@
+/*
+ * File:    PipelineBench.cpp
+ * Author:  Conor Finegan
+ * Contact: conor_finegan@student.uml.edu
+ *
+ * Created on October 17, 2026
+ */
+
+#include "PipelineBench.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+using namespace std;
+
+namespace
+{
+    /**
+     * Name of the file the "write" stage writes to, in the current
+     *      directory. It is removed afterwards.
+     */
+    const char* const WRITE_FILE = "pipeline_bench.xml";
+
+    /**
+     * Name of the file the "write.threadsN" stages write to, which is
+     *      compared with \c WRITE_FILE. It is removed afterwards.
+     */
+    const char* const THREADS_FILE = "pipeline_bench_threads.xml";
+
+    /**
+     * Discards everything written to \c std::cout for as long as it exists,
+     *      so that the benchmarks measure the commands rather than the
+     *      terminal.
+     */
+    class DiscardOutput
+    {
+    public:
+        DiscardOutput() : saved(cout.rdbuf(nullptr)) {}
+        ~DiscardOutput() { cout.rdbuf(saved); }
+
+        DiscardOutput(const DiscardOutput&) = delete;
+        void operator=(const DiscardOutput&) = delete;
+
+    private:
+        streambuf* saved;
+    };
+
+    /**
+     * Builds the result of a benchmark that started at \c start and has
+     *      just finished.
+     * @param name       Name of the benchmark.
+     * @param operations Number of operations performed.
+     * @param start      When the benchmark started.
+     * @return The measurements.
+     */
+    Benchmark::Result Measure(const string& name, const uint64_t operations,
+            const chrono::steady_clock::time_point start)
+    {
+        Benchmark::Result result;
+        result.name = name;
+        result.operations = operations;
+        result.seconds = chrono::duration<double>(
+                chrono::steady_clock::now() - start).count();
+
+        return result;
+    }
+
+    /**
+     * Runs a script through a parser and times it.
+     * @param parser Parser to run the script.
+     * @param script Commands, one per line.
+     * @return Time taken, in seconds.
+     */
+    double TimeScript(InputParser& parser, const string& script)
+    {
+        istringstream exec(script);
+        DiscardOutput discard;
+
+        const auto start = chrono::steady_clock::now();
+        parser.Run(exec);
+
+        return chrono::duration<double>(
+                chrono::steady_clock::now() - start).count();
+    }
+
+    /**
+     * Runs one step of a check through a parser.
+     * @param parser Parser to run the step.
+     * @param step   Name of the step, for the error message.
+     * @param script Commands, one per line.
+     * @throws std::runtime_error if any of the commands fails.
+     */
+    void CheckScript(InputParser& parser, const string& step,
+            const string& script)
+    {
+        const size_t failed = parser.CommandsFailed();
+        TimeScript(parser, script);
+
+        if (parser.CommandsFailed() != failed)
+        {
+            throw runtime_error("The \"" + step + "\" step of the deep "
+                    "chain check failed.");
+        }
+    }
+
+    /**
+     * Reads a whole file.
+     * @param path Path of the file.
+     * @return The contents of the file, or an empty string if it can't be
+     *      read.
+     */
+    string ReadFile(const char* const path)
+    {
+        ifstream file(path, ios::binary);
+        ostringstream contents;
+        contents << file.rdbuf();
+
+        return contents.str();
+    }
+}
+
+constexpr std::size_t PipelineBench::MAX_WRITE_DEPTH;
+constexpr std::size_t PipelineBench::CHECK_DEPTH;
+
+std::vector<Benchmark::Result> PipelineBench::Run(const Options& options)
+{
+    const size_t elements = options.elements;
+    vector<Benchmark::Result> results;
+    vector<string> script;
+
+    // Every element is a child of the root
+    for (size_t i = 0; i < elements; ++ i)
+    {
+        script.push_back("add element root item c" + to_string(i));
+    }
+
+    RunScenario("wide", script, options, results);
+    script.clear();
+
+    // Every element is a child of the one before it. The "deep" tree stops
+    //      where writing it needs a stack of its own; the "chain" carries on
+    //      for every element, and is only printed.
+    script.push_back("add element root n0");
+
+    for (size_t i = 1; i < elements; ++ i)
+    {
+        if (i == MAX_WRITE_DEPTH)
+        {
+            RunScenario("deep", script, options, results);
+        }
+
+        script.push_back("add element n" + to_string(i - 1) + " n" +
+                to_string(i));
+    }
+
+    if (elements <= MAX_WRITE_DEPTH)
+    {
+        RunScenario("deep", script, options, results);
+    }
+
+    RunScenario("chain", script, options, results, false);
+    script.clear();
+
+    // Half of the elements share a name, and the other half are added to
+    //      the first of them, so each lookup finds every one
+    for (size_t i = 0; i < elements / 2; ++ i)
+    {
+        script.push_back("add element root dup");
+    }
+
+    for (size_t i = elements / 2; i < elements; ++ i)
+    {
+        script.push_back("add element dup leaf");
+    }
+
+    RunScenario("duplicates", script, options, results);
+    script.clear();
+
+    // A single element with many attributes
+    script.push_back("add element root item");
+
+    for (size_t i = 1; i < elements; ++ i)
+    {
+        script.push_back("add attribute item a" + to_string(i) + " v" +
+                to_string(i));
+    }
+
+    RunScenario("attributes", script, options, results);
+
+    return results;
+}
+
+void PipelineBench::CheckDeepChain(const std::size_t depth)
+{
+    InputParser parser;
+    parser.SetBatchMode(true);
+    parser.SetSelectionPolicy(DOMUtil::SelectionPolicy::First);
+    parser.SetVerbosity(InputParser::Verbosity::Quiet);
+
+    // Every element is a child of the one before it
+    const string last = "n" + to_string(depth - 1);
+    string build = "add element root n0\n";
+
+    for (size_t i = 1; i < depth; ++ i)
+    {
+        build += "add element n" + to_string(i - 1) + " n" + to_string(i) +
+                "\n";
+    }
+
+    CheckScript(parser, "build", build);
+    CheckScript(parser, "print", "print\n");
+    CheckScript(parser, "write", string("write ") + WRITE_FILE + "\n");
+
+    const string written = ReadFile(WRITE_FILE);
+    remove(WRITE_FILE);
+
+    if (written.find("<" + last) == string::npos)
+    {
+        throw runtime_error("The document written by the deep chain check "
+                "is missing its deepest element.");
+    }
+
+    // Deleting the first element takes the whole chain with it
+    CheckScript(parser, "delete", "delete n0\n");
+
+    const size_t failed = parser.CommandsFailed();
+    TimeScript(parser, "print " + last + "\n");
+
+    if (parser.CommandsFailed() == failed)
+    {
+        throw runtime_error("The deep chain check found " + last +
+                " after deleting the chain.");
+    }
+}
+
+void PipelineBench::RunScenario(const std::string& name,
+        const std::vector<std::string>& script, const Options& options,
+        std::vector<Benchmark::Result>& results, const bool writes)
+{
+    const CommandGrammar& grammar = CommandGrammar::Instance();
+    const uint64_t commands = script.size();
+
+    // Each command adds one node, and the document starts with its root
+    const uint64_t nodes = commands + 1;
+
+    // Parse: tokenize every line and identify its command
+    CommandGrammar::TokenList tokens;
+    volatile size_t recognized = 0;
+    auto start = chrono::steady_clock::now();
+
+    for (size_t pass = 0; pass < options.passes; ++ pass)
+    {
+        for (const string& line : script)
+        {
+            CommandGrammar::Tokenize(line, tokens);
+
+            if (!tokens.empty() && grammar.Lookup(tokens[0]) !=
+                    CommandGrammar::Keyword::Unknown)
+            {
+                recognized = recognized + 1;
+            }
+        }
+    }
+
+    results.push_back(Measure(name + ".parse", commands * options.passes,
+            start));
+
+    // Build: run the script on a fresh parser, unattended and quiet
+    InputParser parser;
+    parser.SetBatchMode(true);
+    parser.SetSelectionPolicy(DOMUtil::SelectionPolicy::First);
+    parser.SetVerbosity(InputParser::Verbosity::Quiet);
+
+    string build;
+    for (const string& line : script)
+    {
+        build += line;
+        build += '\n';
+    }
+
+    Benchmark::Result result;
+    result.name = name + ".build";
+    result.operations = commands;
+    result.seconds = TimeScript(parser, build);
+    results.push_back(result);
+
+    // Print and write the finished document
+    string print;
+    string write;
+    for (size_t pass = 0; pass < options.passes; ++ pass)
+    {
+        print += "print\n";
+        write += string("write ") + WRITE_FILE + "\n";
+    }
+
+    result.name = name + ".print";
+    result.operations = nodes * options.passes;
+    result.seconds = TimeScript(parser, print);
+    results.push_back(result);
+
+    if (!writes)
+    {
+        return;
+    }
+
+    result.name = name + ".write";
+    result.seconds = TimeScript(parser, write);
+    results.push_back(result);
+
+    // Write on 2, 4, 8... threads, and finally on the most asked for
+    vector<size_t> thread_counts;
+    for (size_t threads = 2; threads < options.threads; threads *= 2)
+    {
+        thread_counts.push_back(threads);
+    }
+
+    if (options.threads > 1)
+    {
+        thread_counts.push_back(options.threads);
+    }
+
+    const string expected = ReadFile(WRITE_FILE);
+
+    for (const size_t threads : thread_counts)
+    {
+        const string command = string("write ") + THREADS_FILE +
+                " threads=" + to_string(threads) + "\n";
+
+        write.clear();
+        for (size_t pass = 0; pass < options.passes; ++ pass)
+        {
+            write += command;
+        }
+
+        result.name = name + ".write.threads" + to_string(threads);
+        result.seconds = TimeScript(parser, write);
+        results.push_back(result);
+
+        if (ReadFile(THREADS_FILE) != expected)
+        {
+            remove(WRITE_FILE);
+            remove(THREADS_FILE);
+            throw runtime_error("The document written by " + result.name +
+                    " differs from the one written on a single thread.");
+        }
+    }
+
+    remove(WRITE_FILE);
+    remove(THREADS_FILE);
+}
+
+void PipelineBench::WriteCsv(const std::vector<Benchmark::Result>& results,
+        std::ostream& out)
+{
+    out << "benchmark,operations,seconds,per_second\n";
+
+    for (const Benchmark::Result& result : results)
+    {
+        // Format separately, so that the stream's flags are untouched
+        ostringstream line;
+        line << result.name << "," << result.operations << "," << fixed
+                << setprecision(6) << result.seconds << ","
+                << setprecision(1) << result.PerSecond() << "\n";
+
+        out << line.str();
+    }
+
+    out.flush();
+}
+
+void PipelineBench::WriteJson(const Options& options,
+        const std::vector<Benchmark::Result>& results, std::ostream& out)
+{
+    out << "{\n  \"elements\": " << options.elements << ",\n  \"passes\": "
+            << options.passes << ",\n  \"threads\": " << options.threads
+            << ",\n  \"results\": [";
+
+    for (size_t i = 0; i < results.size(); ++ i)
+    {
+        const Benchmark::Result& result = results[i];
+
+        // Names are generated above, so they never need escaping
+        ostringstream entry;
+        entry << (i == 0 ? "\n" : ",\n") << "    { \"name\": \""
+                << result.name << "\", \"operations\": " << result.operations
+                << ", \"seconds\": " << fixed << setprecision(6)
+                << result.seconds << ", \"per_second\": " << setprecision(1)
+                << result.PerSecond() << " }";
+
+        out << entry.str();
+    }
+
+    out << "\n  ]\n}" << endl;
+}
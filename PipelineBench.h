@@ -0,0 +1,156 @@
+/*
+ * File:    PipelineBench.h
+ * Author:  Conor Finegan
+ * Contact: conor_finegan@student.uml.edu
+ *
+ * Created on October 17, 2026
+ */
+
+#ifndef PIPELINEBENCH_H
+#define	PIPELINEBENCH_H
+
+#include "Benchmark.h"
+#include "CommandGrammar.h"
+#include "InputParser.h"
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * The \c PipelineBench class measures the whole command pipeline, from a
+ *      line of text to a changed (and printed, and written) document. It
+ *      generates synthetic autoexec scripts for several shapes of document
+ *      and runs them through \c InputParser, timing each stage separately:
+ *      <ul>
+ *      <li>"parse": splitting the lines into tokens and looking up their
+ *          keywords, without running them (commands per second).</li>
+ *      <li>"build": running the script, which adds every element and
+ *          attribute (commands per second).</li>
+ *      <li>"print": printing the finished document (nodes per second).</li>
+ *      <li>"write": writing the finished document to a file (nodes per
+ *          second).</li>
+ *      <li>"write.threadsN": writing it on N threads (nodes per second),
+ *          for N = 2, 4, 8... up to \c Options::threads. The output is
+ *          checked against that of the "write" stage byte for byte.</li>
+ *      </ul>
+ *      The benchmarks are built into their own executable; see
+ *      bench_main.cpp and the "bench" target of the Makefile.
+ * @author Conor Finegan<br>conor_finegan@student.uml.edu
+ * @version 1.0
+ */
+class PipelineBench final
+{
+public:
+
+    /**
+     * Size of the benchmarks.
+     */
+    struct Options
+    {
+        /**
+         * Number of elements (or attributes) each script adds. The "deep"
+         *      tree is limited to \c MAX_WRITE_DEPTH levels; the "chain" tree
+         *      is not.
+         */
+        std::size_t elements = 10000;
+
+        /**
+         * Number of times the script is parsed, and the document printed
+         *      and written.
+         */
+        std::size_t passes = 5;
+
+        /**
+         * Highest number of threads the document is written on. With 1, only
+         *      the single-threaded "write" stage is run.
+         */
+        std::size_t threads = 1;
+    };
+
+    /**
+     * Deepest tree that is written. Writing goes through \c DOMLSSerializer,
+     *      which is recursive, so deeper trees are written on a thread with a
+     *      stack to match (see \c DocumentWriter), which would dominate the
+     *      timings. Printing is iterative, and is also timed on deeper trees.
+     */
+    static constexpr std::size_t MAX_WRITE_DEPTH = 1000;
+
+    /**
+     * Depth of the chain built by CheckDeepChain() for "make check".
+     */
+    static constexpr std::size_t CHECK_DEPTH = 100000;
+
+    /**
+     * Runs every stage of every scenario: a wide tree (all elements under
+     *      the root), a deep tree (each element under the last, up to
+     *      \c MAX_WRITE_DEPTH levels), a chain of every element under the
+     *      last (not written), many elements sharing a name (each new
+     *      element looks up the first of them), and many attributes on a
+     *      single element. Output of the commands is discarded while they
+     *      are timed.
+     * @param options Size of the benchmarks.
+     * @return One result per scenario and stage, named
+     *      "<scenario>.<stage>", e.g. "wide.build".
+     * @throws std::runtime_error if a document written on several threads
+     *      differs from the one written on a single thread.
+     */
+    static std::vector<Benchmark::Result> Run(const Options& options);
+
+    /**
+     * Checks that the commands cope with a deep document: builds a chain of
+     *      elements, each under the last, through \c InputParser::Run(),
+     *      then prints it, writes it to a file and deletes it. Output of the
+     *      commands is discarded.
+     * @param depth Number of elements in the chain.
+     * @throws std::runtime_error naming the step that failed, if any
+     *      command fails, the written file lacks the deepest element, or the
+     *      chain is still there after it is deleted.
+     */
+    static void CheckDeepChain(const std::size_t depth);
+
+    /**
+     * Writes results as CSV, one line per result after a header line.
+     * @param results Results to write.
+     * @param out     Stream to write to.
+     */
+    static void WriteCsv(const std::vector<Benchmark::Result>& results,
+            std::ostream& out);
+
+    /**
+     * Writes results as a JSON object, holding the options the benchmarks
+     *      were run with and an array of results.
+     * @param options Options the benchmarks were run with.
+     * @param results Results to write.
+     * @param out     Stream to write to.
+     */
+    static void WriteJson(const Options& options,
+            const std::vector<Benchmark::Result>& results, std::ostream& out);
+
+private:
+
+    /**
+     * Construction of \c PipelineBench objects is prohibited, as this class
+     *      contains only static data.
+     */
+    PipelineBench() = delete;
+
+    /**
+     * Times every stage of one scenario.
+     * @param name    Name of the scenario.
+     * @param script  Commands that build the document, one per line.
+     * @param options Size of the benchmarks.
+     * @param results The results are appended here.
+     * @param writes  \c false to skip the "write" stages, for trees deeper
+     *      than \c MAX_WRITE_DEPTH.
+     * @throws std::runtime_error if the output of several threads differs
+     *      from that of a single thread.
+     */
+    static void RunScenario(const std::string& name,
+            const std::vector<std::string>& script, const Options& options,
+            std::vector<Benchmark::Result>& results, const bool writes = true);
+};
+
+#endif	/* PIPELINEBENCH_H */
+
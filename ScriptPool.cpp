@@ -0,0 +1,191 @@
+/*
+ * File:    ScriptPool.cpp
+ * Author:  Conor Finegan
+ * Contact: conor_finegan@student.uml.edu
+ *
+ * Created on October 17, 2026
+ */
+
+#include "ScriptPool.h"
+#include "LocalStr.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <system_error>
+#include <thread>
+
+#include <xercesc/util/OutOfMemoryException.hpp>
+
+using namespace std;
+XERCES_CPP_NAMESPACE_USE
+
+std::vector<ScriptPool::Outcome> ScriptPool::Run(
+        const std::vector<std::string>& scripts, const Options& options)
+{
+    vector<Outcome> outcomes(scripts.size());
+    atomic<size_t> next(0);
+
+    // Each thread takes the next script until there are none left. Every
+    //      outcome is written by exactly one thread.
+    const auto work = [&]()
+    {
+        for (size_t i = next++; i < scripts.size(); i = next++)
+        {
+            outcomes[i] = RunScript(scripts[i], options);
+        }
+    };
+
+    // The calling thread is one of the workers
+    const size_t threads = min(max<size_t>(options.jobs, 1), scripts.size());
+    vector<thread> workers;
+
+    try
+    {
+        for (size_t i = 1; i < threads; ++ i)
+        {
+            workers.emplace_back(work);
+        }
+    }
+
+    // With fewer threads than asked for, the scripts still all get run
+    catch (const std::system_error&)
+    {
+    }
+
+    work();
+
+    for (thread& worker : workers)
+    {
+        worker.join();
+    }
+
+    return outcomes;
+}
+
+bool ScriptPool::OutputSummary(const std::vector<Outcome>& outcomes,
+        const std::size_t threads, const double seconds, std::ostream& out)
+{
+    size_t completed = 0;
+    size_t commands = 0;
+    size_t failed = 0;
+
+    // Format separately, so that the stream's flags are untouched
+    ostringstream summary;
+    summary << fixed << setprecision(3);
+
+    for (const Outcome& outcome : outcomes)
+    {
+        summary << outcome.script << ": ";
+
+        if (outcome.error.empty())
+        {
+            summary << outcome.commands << " commands, " << outcome.failed
+                    << " failed, " << outcome.seconds * 1000.0 << " ms";
+            ++ completed;
+        }
+
+        else
+        {
+            summary << "Error: " << outcome.error;
+        }
+
+        summary << " (output in " << outcome.output << ")\n";
+
+        commands += outcome.commands;
+        failed += outcome.failed;
+    }
+
+    summary << "\nRan " << outcomes.size() << " scripts on " << threads
+            << " threads in " << seconds * 1000.0 << " ms: " << completed
+            << " completed, " << (outcomes.size() - completed)
+            << " could not be run, and " << failed << " of " << commands
+            << " commands failed.\n";
+
+    out << summary.str() << flush;
+
+    return completed == outcomes.size();
+}
+
+ScriptPool::Outcome ScriptPool::RunScript(const std::string& script,
+        const Options& options)
+{
+    Outcome outcome;
+    outcome.script = script;
+    outcome.output = script + ".out";
+
+    const auto start = chrono::steady_clock::now();
+
+    ofstream file(outcome.output.c_str());
+    if (!file)
+    {
+        outcome.error = "Failed to open the output file.";
+        return outcome;
+    }
+
+    try
+    {
+        InputParser parser(file);
+
+        if (options.policy_specified)
+        {
+            parser.SetSelectionPolicy(options.policy);
+        }
+
+        parser.SetBatchMode(true);
+        parser.SetVerbosity(options.verbosity);
+
+        // The parser explains in the output file why either one failed
+        if (!options.load_file.empty() &&
+                !parser.Load(options.load_file, options.load_options))
+        {
+            outcome.error = "Failed to load the document.";
+        }
+
+        else if (!parser.Run(script))
+        {
+            outcome.error = "Failed to load the script.";
+        }
+
+        outcome.commands = parser.CommandsRun();
+        outcome.failed = parser.CommandsFailed();
+
+        if (options.stats)
+        {
+            file << "\nCommand statistics:" << endl;
+            parser.OutputStats();
+        }
+    }
+
+    // Only this script is lost; the others carry on
+    catch (const OutOfMemoryException&)
+    {
+        outcome.error = "OutOfMemoryException";
+    }
+
+    catch (const DOMException& err)
+    {
+        ostringstream message;
+        message << "DOMException code " << err.code << ": "
+                << LocalStr(err.msg);
+        outcome.error = message.str();
+    }
+
+    catch (const std::exception& err)
+    {
+        outcome.error = err.what();
+    }
+
+    catch (...)
+    {
+        outcome.error = "An unspecified exception was thrown.";
+    }
+
+    outcome.seconds = chrono::duration<double>(
+            chrono::steady_clock::now() - start).count();
+
+    return outcome;
+}
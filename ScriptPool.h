@@ -0,0 +1,134 @@
+/*
+ * File:    ScriptPool.h
+ * Author:  Conor Finegan
+ * Contact: conor_finegan@student.uml.edu
+ *
+ * Created on October 17, 2026
+ */
+
+#ifndef SCRIPTPOOL_H
+#define	SCRIPTPOOL_H
+
+#include "DOMUtil.h"
+#include "DocumentLoader.h"
+#include "InputParser.h"
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * The \c ScriptPool class runs many independent autoexec scripts at once, on
+ *      a pool of threads. Each script gets an \c InputParser (and so a
+ *      workspace of documents) of its own, run unattended as in batch mode,
+ *      and everything it prints is written to a file of its own. The
+ *      threads take the next script from a shared queue as soon as they
+ *      finish one, so long and short scripts even out. Documents don't share
+ *      any nodes, so the scripts don't wait on each other.
+ * @author Conor Finegan<br>conor_finegan@student.uml.edu
+ * @version 1.0
+ */
+class ScriptPool final
+{
+public:
+
+    /**
+     * How the scripts are run.
+     */
+    struct Options
+    {
+        /** Number of threads, at most one per script. */
+        std::size_t jobs = 1;
+
+        /** \c true to apply \c policy; batch mode uses "first" otherwise. */
+        bool policy_specified = false;
+
+        /** How a name that matches several elements is resolved. */
+        DOMUtil::SelectionPolicy policy = DOMUtil::SelectionPolicy::First;
+
+        /** How much each script reports about its commands. */
+        InputParser::Verbosity verbosity = InputParser::Verbosity::Normal;
+
+        /** \c true to end each output file with the command statistics. */
+        bool stats = false;
+
+        /**
+         * XML file each script starts from, instead of an empty document.
+         *      Empty for none.
+         */
+        std::string load_file;
+
+        /** How \c load_file is parsed. */
+        DocumentLoader::Options load_options;
+    };
+
+    /**
+     * How one script went.
+     */
+    struct Outcome
+    {
+        /** Path of the script. */
+        std::string script;
+
+        /**
+         * File that received the script's output: the script's path
+         *      followed by ".out".
+         */
+        std::string output;
+
+        /** Why the script couldn't be run to the end, or empty if it was. */
+        std::string error;
+
+        /** Number of commands run. */
+        std::size_t commands = 0;
+
+        /** Number of those that reported an error. */
+        std::size_t failed = 0;
+
+        /** Time taken, in seconds. */
+        double seconds = 0.0;
+    };
+
+    /**
+     * Runs every script and waits for all of them to finish.
+     * @param scripts Paths of the scripts.
+     * @param options How to run them.
+     * @return How each script went, in the same order as \c scripts.
+     */
+    static std::vector<Outcome> Run(const std::vector<std::string>& scripts,
+            const Options& options);
+
+    /**
+     * Prints a line for each script, then the totals.
+     * @param outcomes What Run() returned.
+     * @param threads  Number of threads the scripts were run on.
+     * @param seconds  Time taken by Run().
+     * @param out      Stream to print to.
+     * @return \c true if every script was run to the end.
+     */
+    static bool OutputSummary(const std::vector<Outcome>& outcomes,
+            const std::size_t threads, const double seconds,
+            std::ostream& out);
+
+private:
+
+    /**
+     * Construction of \c ScriptPool objects is prohibited, as this class
+     *      contains only static data.
+     */
+    ScriptPool() = delete;
+
+    /**
+     * Runs a single script on the calling thread. Never throws; errors are
+     *      recorded in the outcome.
+     * @param script  Path of the script.
+     * @param options How to run it.
+     * @return How it went.
+     */
+    static Outcome RunScript(const std::string& script,
+            const Options& options);
+};
+
+#endif	/* SCRIPTPOOL_H */
+
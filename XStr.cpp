@@ -8,28 +8,60 @@
  * UPDATE 11/26/15: Copy and movement have been removed and disabled because of 
  *                  concerns regarding the deletion of resources across DLL
  *                  boundaries.
+ * 
+ * UPDATE 10/17/26: Short ASCII strings are now widened into a buffer inside
+ *                  the object, so the common case never touches the heap.
  */
 
 #include "XStr.h"
 
 XERCES_CPP_NAMESPACE_USE
 
+constexpr std::size_t XStr::SMALL_CAPACITY;
+
 XStr::XStr(const char* const char_str)
 {
-    // Convert input string from local system encoding to unicode
-    unicode_form = XMLString::transcode(char_str);
+    Transcode(char_str);
 }
 
 XStr::XStr(const std::string& char_str)
 {
-    unicode_form = XMLString::transcode(char_str.c_str());
+    Transcode(char_str.c_str());
 }
 
 XStr::~XStr() noexcept
 {
-    // De-allocate the unicode string
+    // De-allocate the unicode string, unless it's stored in the object
     // If this call fails, the program will call \c std::terminate
-    XMLString::release(&unicode_form);
+    if (unicode_form != small_form)
+    {
+        XMLString::release(&unicode_form);
+    }
+}
+
+void XStr::Transcode(const char* const char_str)
+{
+    // transcode() would also return null
+    if (!char_str) { return; }
+    
+    // Fast path: ASCII is the same in the local code page and in Unicode, so
+    //      it can be widened one character at a time
+    for (std::size_t i = 0; i < SMALL_CAPACITY; ++ i)
+    {
+        const unsigned char c = char_str[i];
+        if (c >= 0x80) { break; }
+        
+        small_form[i] = c;
+        
+        if (c == 0)
+        {
+            unicode_form = small_form;
+            return;
+        }
+    }
+    
+    // Convert input string from local system encoding to unicode
+    unicode_form = XMLString::transcode(char_str);
 }
 
 const XMLCh* XStr::get_unicode_form()
@@ -14,21 +14,27 @@
  * UPDATE 11/26/15: Copy and movement have been removed and disabled because of 
  *                  concerns regarding the deletion of resources across DLL
  *                  boundaries.
+ * 
+ * UPDATE 10/17/26: Short ASCII strings are now widened into a buffer inside
+ *                  the object, so the common case never touches the heap.
  */
 
 #ifndef XSTR_H
 #define	XSTR_H
 
 #include <xercesc/util/XMLString.hpp>
+#include <cstddef>
 #include <string>
 
 /**
  * Wrapper class for a Unicode-form C-String that will, upon destruction,
  *      automatically deallocate its member string using the DLL-safe 
- *      \c XMLString::release method.
+ *      \c XMLString::release method. Strings of fewer than \c SMALL_CAPACITY
+ *      ASCII characters are stored inside the object instead, and are never
+ *      allocated or released.
  * @param char_str system-local string of type \c char* to be transcoded and stored.
  * @author Conor Finegan<br>conor_finegan@student.uml.edu
- * @version 1.1
+ * @version 1.2
  */
 class XStr final
 {
@@ -77,12 +83,30 @@ public:
      */
     const XMLCh* get_unicode_form();
     
+    /**
+     * Capacity of the internal buffer, including the null terminator.
+     */
+    static constexpr std::size_t SMALL_CAPACITY = 64;
+    
 private:
     
+    /**
+     * Stores the Unicode form of \c char_str in \c small_form if it is short
+     *      enough and entirely ASCII, otherwise transcodes it onto the heap.
+     * @param char_str C-String to encode. May be null.
+     */
+    void Transcode(const char* const char_str);
+    
     /**
      * Pointer to the Xerces-c compatible Unicode interpretation of the string.
+     *      Points either to \c small_form or to memory owned by Xerces-c.
      */
     XMLCh* unicode_form = nullptr;
+    
+    /**
+     * Storage for short strings.
+     */
+    XMLCh small_form[SMALL_CAPACITY];
 };
 
 /**
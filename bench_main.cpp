@@ -0,0 +1,229 @@
+/*
+ * File:    bench_main.cpp
+ * Author:  Conor Finegan
+ * Contact: conor_finegan@student.uml.edu
+ *
+ * Created on October 17, 2026
+ */
+
+// Entry point of the benchmark suite, which is built separately from the
+//      program itself with "make bench". See PipelineBench.h.
+
+#include <algorithm> // for max
+#include <cerrno>    // for errno
+#include <cstdlib>   // for strtoul
+#include <fstream>   // for ofstream
+#include <iostream>  // for cout and friends
+#include <string>    // for the STL string class
+#include <thread>    // for hardware_concurrency
+
+#include "PipelineBench.h"
+
+/**
+ * Prints the command line syntax of the benchmark suite to standard error.
+ * @param program name the program was invoked with
+ */
+static void PrintUsage(const char* program)
+{
+    using namespace std;
+
+    cerr << "Usage: " << program << " [options]" << endl
+            << "Options:" << endl
+            << "  --elements=<N>       Number of elements each script adds "
+               "(10000)." << endl
+            << "  --passes=<N>         Number of times each script is "
+               "parsed, and each" << endl
+            << "                       document printed and written (5)."
+            << endl
+            << "  --threads=<N>        Most threads each document is "
+               "written on (one per core)." << endl
+            << "  --format=<format>    csv (the default) or json." << endl
+            << "  --output=<file>      Write the results to a file instead "
+               "of standard out." << endl
+            << "  --check              Check that a chain of "
+            << PipelineBench::CHECK_DEPTH << " elements can be" << endl
+            << "                       built, printed, written and deleted, "
+               "instead." << endl;
+}
+
+/**
+ * Converts a positive number given on the command line.
+ * @param text  Text of the number.
+ * @param value Receives the number if \c text is valid.
+ * @return \c true if \c text is a positive number.
+ */
+static bool ParseCount(const std::string& text, std::size_t& value)
+{
+    char* endptr = nullptr;
+    errno = 0;
+    const unsigned long number = strtoul(text.c_str(), &endptr, 10);
+
+    if (text.empty() || text[0] == '-' || number == 0 || errno == ERANGE ||
+            *endptr != 0)
+    {
+        return false;
+    }
+
+    value = number;
+    return true;
+}
+
+/**
+ * Runs the benchmark suite and writes its results.
+ * @param argc number of command line arguments
+ * @param argv array of command line arguments
+ * @return \c EXIT_SUCCESS if the benchmarks ran and their results were
+ *      written.
+ */
+int main(int argc, char** argv)
+{
+    using namespace std;
+    XERCES_CPP_NAMESPACE_USE
+
+    PipelineBench::Options options;
+    options.threads = max(thread::hardware_concurrency(), 1u);
+    bool json = false;
+    bool check = false;
+    string output;
+
+    for (int i = 1; i < argc; ++ i)
+    {
+        const string arg = argv[i];
+        const string elements_option = "--elements=";
+        const string passes_option = "--passes=";
+        const string threads_option = "--threads=";
+        const string output_option = "--output=";
+        bool valid = true;
+
+        if (arg.compare(0, elements_option.size(), elements_option) == 0)
+        {
+            valid = ParseCount(arg.substr(elements_option.size()),
+                    options.elements);
+        }
+
+        else if (arg.compare(0, passes_option.size(), passes_option) == 0)
+        {
+            valid = ParseCount(arg.substr(passes_option.size()),
+                    options.passes);
+        }
+
+        else if (arg.compare(0, threads_option.size(), threads_option) == 0)
+        {
+            valid = ParseCount(arg.substr(threads_option.size()),
+                    options.threads) && options.threads <= 256;
+        }
+
+        else if (arg == "--format=csv")
+        {
+            json = false;
+        }
+
+        else if (arg == "--format=json")
+        {
+            json = true;
+        }
+
+        else if (arg == "--check")
+        {
+            check = true;
+        }
+
+        else if (arg.compare(0, output_option.size(), output_option) == 0 &&
+                arg.size() > output_option.size())
+        {
+            output = arg.substr(output_option.size());
+        }
+
+        else
+        {
+            valid = false;
+        }
+
+        if (!valid)
+        {
+            cerr << "Error: Unexpected argument: " << arg << endl;
+            PrintUsage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    // Initialize the XML4C2 system
+    try
+    {
+        XMLPlatformUtils::Initialize();
+    }
+
+    catch (const XMLException& err)
+    {
+        cerr << "Error during Xerces-C Initialization." << endl
+                << "Exception: " << LSTR(err.getMessage());
+        return EXIT_FAILURE;
+    }
+
+    int status = EXIT_SUCCESS;
+
+    try
+    {
+        if (check)
+        {
+            PipelineBench::CheckDeepChain(PipelineBench::CHECK_DEPTH);
+            cout << "Deep chain check passed (" << PipelineBench::CHECK_DEPTH
+                    << " elements)." << endl;
+        }
+
+        else
+        {
+            const vector<Benchmark::Result> results =
+                    PipelineBench::Run(options);
+
+            ofstream file;
+            if (!output.empty())
+            {
+                file.open(output.c_str());
+            }
+
+            ostream& out = output.empty() ? cout : file;
+
+            if (json)
+            {
+                PipelineBench::WriteJson(options, results, out);
+            }
+
+            else
+            {
+                PipelineBench::WriteCsv(results, out);
+            }
+
+            if (!out)
+            {
+                cerr << "Error: Failed to write the results to: " << output
+                        << endl;
+                status = EXIT_FAILURE;
+            }
+        }
+    }
+
+    catch (const OutOfMemoryException& err)
+    {
+        cerr << "Error: OutOfMemoryException" << endl;
+        cerr << LSTR(err.getMessage()) << endl;
+        return EXIT_FAILURE;
+    }
+
+    catch (const DOMException& err)
+    {
+        cerr << "Error: DOMException code is: " << err.code << endl;
+        cerr << LSTR(err.msg) << endl;
+        return EXIT_FAILURE;
+    }
+
+    catch (const std::exception& err)
+    {
+        cerr << "std::exception: " << err.what() << endl;
+        return EXIT_FAILURE;
+    }
+
+    XMLPlatformUtils::Terminate();
+
+    return status;
+}
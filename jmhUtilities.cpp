@@ -4,6 +4,7 @@
  * 
  * Created on November 23, 2015, 10:46 AM
  * updated by JMH on December 4, 2015 at 4:11 PM to add the StringSplit function
+ * updated on October 17, 2026 to make trim and StringSplit linear-time
  */
 
 #include "jmhUtilities.h"
@@ -32,33 +33,48 @@ jmhUtilities::~jmhUtilities() {
 /**
  * Trim leading and trailing white space (spaces, tabs, and newlines) from the
  *    string passed as an argument and return the trimmed string.
- * This version is more sophisticated than the one above.  It uses iterators
- *    and an improved search technique.
+ * The white space is found with a single scan from each end, so the time
+ *    taken is linear in the length of the string.  Empty strings and strings
+ *    of nothing but white space are trimmed to the empty string.
  * @param str string to trim (a copy, so that the original is not destroyed)
  * @return a copy of the original string with leading and trailing white space removed
  */
 string jmhUtilities::trim( string str ) {
-  // define the iterator to be used in both loops
-  string::iterator it ;
+  size_t first, last ;
+  trimRange( str, first, last ) ;
+
+  // erase the trailing white space first, so that the leading white space is
+  //    still where trimRange found it, then shift the rest down in one step
+  str.erase( last ) ;
+  str.erase( 0, first ) ;
+
+  // return the result
+  return str ;
+}
+
+/**
+ * Find the part of a string that trim would keep, without copying anything.
+ * @param str   string to examine
+ * @param first receives the position of the first character that is not white space
+ * @param last  receives the position one past the last character that is not white space
+ *    (equal to first if the string is nothing but white space)
+ */
+void jmhUtilities::trimRange( const string& str, size_t& first, size_t& last ) {
+  // white space characters; '\r' was added on 12/5/15
+  static const char whitespace[] = " \t\n\r" ;
 
   // search for leading white space characters
-  // Edited on 12/5/15 to include the '\r' character
-  it = str.begin() ;
-  while ( *it == ' ' || *it == '\t' || *it == '\n' || *it == '\r' ) {
-    str.erase( it ) ;   // erase the found whitespace character
-    it = str.begin() ;  // reposition the iterator to the first character in the string
-  }
+  first = str.find_first_not_of( whitespace ) ;
 
-  // search for trailing white space characters
-  // Edited on 12/5/15 to include the '\r' character
-  it = str.end() - 1 ;
-  while ( *it == ' ' || *it == '\t' || *it == '\n' || *it == '\r' ) {
-    str.erase( it ) ;     // erase the found whitespace character
-    it = str.end() - 1 ;  // reposition the iterator to the last character in the string
+  // nothing but white space (or an empty string)
+  if ( first == string::npos ) {
+    first = last = str.size() ;
+    return ;
   }
 
-  // return the result
-  return str ;
+  // search for trailing white space characters; there is at least one
+  //    character that is not white space, so this search succeeds
+  last = str.find_last_not_of( whitespace ) + 1 ;
 }
 
 
@@ -96,27 +112,47 @@ bool jmhUtilities::caseInsCompare( const string& s1, const string& s2 ) {
  */
 vector<string> jmhUtilities::StringSplit( string str, char c ) {
   vector<string> vec ;  // result vector to return
-  
-  // trim leading and trailing spaces from the string
-  // str = jmhUtilities::trim( str ) ;
-  
-  // position of first space character found
-  size_t firstSpacePosition = str.find( c ) ;
-
-  // save each word found
-  while ( firstSpacePosition != string::npos ) {
-    string strExtracted = str.substr( 0, firstSpacePosition ) ;
-    if ( strExtracted.length() != 0 ) {
-      vec.push_back( strExtracted ) ;
-    }
-    str = str.substr( firstSpacePosition + 1 ) ;  // chop off the token found
-    firstSpacePosition = str.find( c ) ;        // find the next space character
-  }
-  // push the last token onto the vector
-  if ( str.compare( "" ) != 0 ) {
-    vec.push_back( str ) ;
-  }
+  StringSplit( str, c, vec ) ;
   
   // return the resultant vector
   return vec ;
+}
+
+/**
+ * This version of StringSplit stores the tokens in a vector supplied by the caller.
+ * The vector's existing strings are overwritten in place, so a vector that is reused
+ * from call to call stops allocating once it has grown to fit.  Each call is linear
+ * in the length of the string.
+ * @param  str    string to split
+ * @param  c      character to use to split the string
+ * @param  tokens receives the tokens found; its previous contents are replaced
+ */
+void jmhUtilities::StringSplit( const string& str, char c, vector<string>& tokens ) {
+  size_t count = 0 ;  // number of tokens found so far
+  size_t start = 0 ;  // position of the token being examined
+
+  // save each word found, moving forward through the string rather than
+  //    chopping the front off it
+  while ( start <= str.size() ) {
+    size_t end = str.find( c, start ) ;
+    if ( end == string::npos ) {
+      end = str.size() ;
+    }
+
+    // empty tokens (from repeated separators) are skipped
+    if ( end != start ) {
+      if ( count < tokens.size() ) {
+        tokens[count].assign( str, start, end - start ) ;  // reuse the string's memory
+      }
+      else {
+        tokens.emplace_back( str, start, end - start ) ;
+      }
+      ++ count ;
+    }
+
+    start = end + 1 ;
+  }
+
+  // drop any strings left over from a previous, longer split
+  tokens.resize( count ) ;
 }
\ No newline at end of file
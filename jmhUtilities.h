@@ -4,6 +4,7 @@
  *
  * Created on November 23, 2015, 10:46 AM
  * updated by JMH on December 4, 2015 at 4:11 PM to add the StringSplit function
+ * updated on October 17, 2026 to make trim and StringSplit linear-time
  */
 
 #ifndef JMHUTILITIES_H
@@ -34,12 +35,22 @@ public:
   /**
    * Trim leading and trailing white space (spaces, tabs, and newlines) from the
    *    string passed as an argument and return the trimmed string.
-   * This version is more sophisticated than the one above.  It uses iterators
-   *    and an improved search technique.
+   * The white space is found with a single scan from each end, so the time
+   *    taken is linear in the length of the string.  Empty strings and strings
+   *    of nothing but white space are trimmed to the empty string.
    * @param str string to trim (a copy, so that the original is not destroyed)
    * @return a copy of the original string with leading and trailing white space removed
    */
   static std::string trim( std::string str ) ;
+
+  /**
+   * Find the part of a string that trim would keep, without copying anything.
+   * @param str   string to examine
+   * @param first receives the position of the first character that is not white space
+   * @param last  receives the position one past the last character that is not white space
+   *    (equal to first if the string is nothing but white space)
+   */
+  static void trimRange( const std::string& str, size_t& first, size_t& last ) ;
   
   /**
    * Compare two characters in a case-insensitive manner by converting them both to
@@ -69,6 +80,17 @@ public:
    */
   static std::vector<std::string> StringSplit(std::string str, char c);
 
+  /**
+   * This version of StringSplit stores the tokens in a vector supplied by the caller.
+   * The vector's existing strings are overwritten in place, so a vector that is reused
+   * from call to call stops allocating once it has grown to fit.  Each call is linear
+   * in the length of the string.
+   * @param  str    string to split
+   * @param  c      character to use to split the string
+   * @param  tokens receives the tokens found; its previous contents are replaced
+   */
+  static void StringSplit(const std::string& str, char c, std::vector<std::string>& tokens);
+
   private:
 
 };
@@ -8,13 +8,100 @@
 // NOTE: Most of the starter code from this file was moved to the InputParser
 //      class. See InputParser.h and InputParser.cpp for more information.
 
+#include <algorithm> // for min
+#include <cerrno>    // for errno
+#include <chrono>    // for steady_clock
+#include <cstdlib>   // for strtoul
 #include <iostream>  // for cout and friends
 #include <sstream>   // for string streams
 #include <string>    // for the STL string class
 #include <regex>     // for regular expressions
+#include <thread>    // for hardware_concurrency
+#include <vector>    // for the list of scripts
 
 #include "jmhUtilities.h"
 #include "InputParser.h"
+#include "ScriptPool.h"
+
+/**
+ * Prints the command line syntax of the program to standard error.
+ * @param program name the program was invoked with
+ */
+static void PrintUsage(const char* program)
+{
+    using namespace std;
+    
+    cerr << "Usage: " << program << " [options] [autoexec file]" << endl
+            << "       " << program << " --jobs[=<N>] [options] <script>..."
+            << endl
+            << "Options:" << endl
+            << "  --batch              Run the autoexec (or standard input) "
+               "unattended and" << endl
+            << "                       exit when it ends. Deletions are not "
+               "confirmed." << endl
+            << "  --ambiguity=<policy> How to resolve a name that matches "
+               "several elements:" << endl
+            << "                       prompt, first, last, all or error. "
+               "Batch mode defaults" << endl
+            << "                       to first." << endl
+            << "  --load=<file>        Load an XML file as the working "
+               "document on startup." << endl
+            << "  --no-validation      Don't validate the loaded file "
+               "against its grammar." << endl
+            << "  --no-namespaces      Don't process namespaces in the "
+               "loaded file." << endl
+            << "  --no-mmap            Read the loaded file through a buffer "
+               "instead of" << endl
+            << "                       mapping it into memory." << endl
+            << "  --verbosity=<level>  quiet to print only errors and a "
+               "summary of each" << endl
+            << "                       script, or normal (the default) to "
+               "confirm every" << endl
+            << "                       command." << endl
+            << "  --quiet              Same as --verbosity=quiet." << endl
+            << "  --stats              Print the timing of every command on "
+               "exit." << endl
+            << "  --jobs[=<N>]         Run every script given unattended, N "
+               "at a time (one per" << endl
+            << "                       core by default). The output of each "
+               "script goes to" << endl
+            << "                       <script>.out, and a summary to "
+               "standard out." << endl;
+}
+
+/**
+ * Runs many scripts at once and prints a summary of how they went.
+ * @param scripts paths of the scripts
+ * @param options how to run them, see \c ScriptPool::Options
+ * @return \c EXIT_SUCCESS if every script was run to the end.
+ */
+static int RunScripts(const std::vector<std::string>& scripts,
+        const ScriptPool::Options& options)
+{
+    using namespace std;
+    
+    try
+    {
+        const auto start = chrono::steady_clock::now();
+        const vector<ScriptPool::Outcome> outcomes = 
+                ScriptPool::Run(scripts, options);
+        const double seconds = chrono::duration<double>(
+                chrono::steady_clock::now() - start).count();
+        
+        const bool completed = ScriptPool::OutputSummary(outcomes, 
+                min(options.jobs, scripts.size()), seconds, cout);
+        
+        return completed ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+    
+    // Errors within a script are caught by the pool; this is for the pool
+    //      itself
+    catch (const std::exception& err)
+    {
+        cerr << "std::exception: " << err.what() << endl;
+        return EXIT_FAILURE;
+    }
+}
 
 /**
  * The standard C++ main function.
@@ -26,6 +113,138 @@ int main(int argc, char** argv)
 {
     using namespace std;
     XERCES_CPP_NAMESPACE_USE
+    
+    // Command line options
+    bool batch = false;
+    bool policy_specified = false;
+    DOMUtil::SelectionPolicy policy = DOMUtil::SelectionPolicy::Prompt;
+    InputParser::Verbosity verbosity = InputParser::Verbosity::Normal;
+    bool stats = false;
+    size_t jobs = 0;
+    vector<string> scripts;
+    string load_file;
+    DocumentLoader::Options load_options;
+    
+    for (int i = 1; i < argc; ++ i)
+    {
+        const string arg = argv[i];
+        const string policy_option = "--ambiguity=";
+        const string load_option = "--load=";
+        const string verbosity_option = "--verbosity=";
+        const string jobs_option = "--jobs=";
+        
+        if (arg == "--batch")
+        {
+            batch = true;
+        }
+        
+        else if (arg.compare(0, policy_option.size(), policy_option) == 0)
+        {
+            policy_specified = true;
+            
+            if (!DOMUtil::ParseSelectionPolicy(
+                    arg.substr(policy_option.size()), policy))
+            {
+                cerr << "Error: Unknown ambiguity policy: " << arg << endl;
+                PrintUsage(argv[0]);
+                return EXIT_FAILURE;
+            }
+        }
+        
+        else if (arg.compare(0, verbosity_option.size(), 
+                verbosity_option) == 0)
+        {
+            if (!InputParser::ParseVerbosity(
+                    arg.substr(verbosity_option.size()), verbosity))
+            {
+                cerr << "Error: Unknown verbosity: " << arg << endl;
+                PrintUsage(argv[0]);
+                return EXIT_FAILURE;
+            }
+        }
+        
+        else if (arg == "--quiet")
+        {
+            verbosity = InputParser::Verbosity::Quiet;
+        }
+        
+        else if (arg == "--stats")
+        {
+            stats = true;
+        }
+        
+        else if (arg == "--jobs")
+        {
+            jobs = max(thread::hardware_concurrency(), 1u);
+        }
+        
+        else if (arg.compare(0, jobs_option.size(), jobs_option) == 0)
+        {
+            const string count = arg.substr(jobs_option.size());
+            char* endptr = nullptr;
+            errno = 0;
+            jobs = strtoul(count.c_str(), &endptr, 10);
+            
+            if (count.empty() || count[0] == '-' || jobs == 0 || 
+                    errno == ERANGE || *endptr != 0)
+            {
+                cerr << "Error: Invalid number of jobs: " << arg << endl;
+                PrintUsage(argv[0]);
+                return EXIT_FAILURE;
+            }
+        }
+        
+        else if (arg.compare(0, load_option.size(), load_option) == 0)
+        {
+            load_file = arg.substr(load_option.size());
+        }
+        
+        else if (arg == "--no-validation")
+        {
+            load_options.validate = false;
+        }
+        
+        else if (arg == "--no-namespaces")
+        {
+            load_options.namespaces = false;
+        }
+        
+        else if (arg == "--no-mmap")
+        {
+            load_options.memory_map = false;
+        }
+        
+        // Arguments that aren't options name the autoexec, or the scripts
+        else if (arg.compare(0, 2, "--") != 0)
+        {
+            scripts.push_back(arg);
+        }
+        
+        else
+        {
+            cerr << "Error: Unexpected argument: " << arg << endl;
+            PrintUsage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    
+    // Only the script pool takes more than one script
+    if (jobs == 0 && scripts.size() > 1)
+    {
+        cerr << "Error: Unexpected argument: " << scripts[1] << endl;
+        PrintUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+    
+    if (jobs > 0 && scripts.empty())
+    {
+        cerr << "Error: --jobs needs at least one script." << endl;
+        PrintUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+    
+    // Exit status of the program loop
+    int status = EXIT_SUCCESS;
             
     // Initialize the XML4C2 system
     try
@@ -40,25 +259,69 @@ int main(int argc, char** argv)
                 << "Exception: " << LSTR(err.getMessage());
         return EXIT_FAILURE;
     }
+    
+    // Hand the scripts to the pool, which has a parser for each one
+    if (jobs > 0)
+    {
+        ScriptPool::Options pool_options;
+        pool_options.jobs = jobs;
+        pool_options.policy_specified = policy_specified;
+        pool_options.policy = policy;
+        pool_options.verbosity = verbosity;
+        pool_options.stats = stats;
+        pool_options.load_file = load_file;
+        pool_options.load_options = load_options;
+        
+        status = RunScripts(scripts, pool_options);
+        
+        XMLPlatformUtils::Terminate();
+        return status;
+    }
    
     // Create parser object and enter program loop
     try
     {
         // Initialize parser
         InputParser parser;
+        
+        if (policy_specified)
+        {
+            parser.SetSelectionPolicy(policy);
+        }
+        
+        parser.SetBatchMode(batch);
+        parser.SetVerbosity(verbosity);
 
-        // display program title if input object initializes
-        cout << "Assignment No. 7:" << endl;
-        cout << "Parsing a Command Line Using Regular Expressions" << endl;
-        cout << "Author:  Conor Finegan" << endl;
-        cout << "Contact: conor_finegan@student.uml.edu" << endl;
-        cout << "Type \"help\" for command reference" << endl;
+        // display program title if input object initializes, unless there is
+        //      no one to read it
+        if (!batch)
+        {
+            cout << "Assignment No. 7:" << endl;
+            cout << "Parsing a Command Line Using Regular Expressions" << endl;
+            cout << "Author:  Conor Finegan" << endl;
+            cout << "Contact: conor_finegan@student.uml.edu" << endl;
+            cout << "Type \"help\" for command reference" << endl;
+        }
+        
+        // Replace the starting document if asked to. A document that can't be
+        //      loaded is only fatal when running unattended.
+        if (!load_file.empty() && !parser.Load(load_file, load_options) && 
+                batch)
+        {
+            status = EXIT_FAILURE;
+        }
         
         // Run parser with command list if available
-        // Autoexec is specified by argv[1]]
-        if (argc > 1)
+        else if (!scripts.empty())
         {
-            parser.Run(argv[1]);
+            // A missing script is only fatal when running unattended
+            if (!parser.Run(scripts[0]) && batch) { status = EXIT_FAILURE; }
+        }
+        
+        // In batch mode, commands are read from standard input until it ends
+        else if (batch)
+        {
+            parser.Run(cin);
         }
         
         // Otherwise use default Run method
@@ -66,6 +329,12 @@ int main(int argc, char** argv)
         {
             parser.Run();
         }
+        
+        if (stats)
+        {
+            cout << "\nCommand statistics:" << endl;
+            parser.OutputStats();
+        }
     }
     
     // Catch out-of-memory exceptions from Xerces-C
@@ -103,5 +372,5 @@ int main(int argc, char** argv)
     //      why it's ignored in the catch blocks above)
     XMLPlatformUtils::Terminate();
     
-    return EXIT_SUCCESS;
+    return status;
 }
\ No newline at end of file
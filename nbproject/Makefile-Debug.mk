@@ -35,10 +35,24 @@ OBJECTDIR=${CND_BUILDDIR}/${CND_CONF}/${CND_PLATFORM}
 
 # Object Files
 OBJECTFILES= \
+	${OBJECTDIR}/ArenaMemoryManager.o \
+	${OBJECTDIR}/Benchmark.o \
 	${OBJECTDIR}/CmdUtil.o \
+	${OBJECTDIR}/CommandGrammar.o \
+	${OBJECTDIR}/CommandStats.o \
+	${OBJECTDIR}/CompressedFormatTarget.o \
 	${OBJECTDIR}/DOMUtil.o \
+	${OBJECTDIR}/DocumentLoader.o \
+	${OBJECTDIR}/DocumentStreamer.o \
+	${OBJECTDIR}/DocumentWriter.o \
+	${OBJECTDIR}/FdFormatTarget.o \
 	${OBJECTDIR}/InputParser.o \
 	${OBJECTDIR}/LocalStr.o \
+	${OBJECTDIR}/MappedFile.o \
+	${OBJECTDIR}/NameCache.o \
+	${OBJECTDIR}/NodeIndex.o \
+	${OBJECTDIR}/NodePath.o \
+	${OBJECTDIR}/ScriptPool.o \
 	${OBJECTDIR}/XStr.o \
 	${OBJECTDIR}/jmhUtilities.o \
 	${OBJECTDIR}/main.o
@@ -48,8 +62,8 @@ OBJECTFILES= \
 CFLAGS=
 
 # CC Compiler Flags
-CCFLAGS=-std=c++11 -Wall -pedantic
-CXXFLAGS=-std=c++11 -Wall -pedantic
+CCFLAGS=-std=c++11 -Wall -pedantic -pthread ${ZSTD_CXXFLAGS}
+CXXFLAGS=-std=c++11 -Wall -pedantic -pthread ${ZSTD_CXXFLAGS}
 
 # Fortran Compiler Flags
 FFLAGS=
@@ -58,7 +72,7 @@ FFLAGS=
 ASFLAGS=
 
 # Link Libraries and Options
-LDLIBSOPTIONS=-lxerces-c
+LDLIBSOPTIONS=-lxerces-c -lz -lpthread ${ZSTD_LIBS}
 
 # Build Targets
 .build-conf: ${BUILD_SUBPROJECTS}
@@ -68,16 +82,61 @@ ${CND_DISTDIR}/${CND_CONF}/${CND_PLATFORM}/comp-iv-final-assignment.exe: ${OBJEC
 	${MKDIR} -p ${CND_DISTDIR}/${CND_CONF}/${CND_PLATFORM}
 	${LINK.cc} -o ${CND_DISTDIR}/${CND_CONF}/${CND_PLATFORM}/comp-iv-final-assignment ${OBJECTFILES} ${LDLIBSOPTIONS}
 
+${OBJECTDIR}/ArenaMemoryManager.o: ArenaMemoryManager.cpp 
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} "$@.d"
+	$(COMPILE.cc) -g -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/ArenaMemoryManager.o ArenaMemoryManager.cpp
+
+${OBJECTDIR}/Benchmark.o: Benchmark.cpp 
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} "$@.d"
+	$(COMPILE.cc) -g -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/Benchmark.o Benchmark.cpp
+
 ${OBJECTDIR}/CmdUtil.o: CmdUtil.cpp 
 	${MKDIR} -p ${OBJECTDIR}
 	${RM} "$@.d"
 	$(COMPILE.cc) -g -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/CmdUtil.o CmdUtil.cpp
 
+${OBJECTDIR}/CommandGrammar.o: CommandGrammar.cpp 
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} "$@.d"
+	$(COMPILE.cc) -g -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/CommandGrammar.o CommandGrammar.cpp
+
+${OBJECTDIR}/CommandStats.o: CommandStats.cpp 
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} "$@.d"
+	$(COMPILE.cc) -g -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/CommandStats.o CommandStats.cpp
+
+${OBJECTDIR}/CompressedFormatTarget.o: CompressedFormatTarget.cpp 
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} "$@.d"
+	$(COMPILE.cc) -g -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/CompressedFormatTarget.o CompressedFormatTarget.cpp
+
 ${OBJECTDIR}/DOMUtil.o: DOMUtil.cpp 
 	${MKDIR} -p ${OBJECTDIR}
 	${RM} "$@.d"
 	$(COMPILE.cc) -g -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/DOMUtil.o DOMUtil.cpp
 
+${OBJECTDIR}/DocumentLoader.o: DocumentLoader.cpp 
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} "$@.d"
+	$(COMPILE.cc) -g -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/DocumentLoader.o DocumentLoader.cpp
+
+${OBJECTDIR}/DocumentStreamer.o: DocumentStreamer.cpp 
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} "$@.d"
+	$(COMPILE.cc) -g -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/DocumentStreamer.o DocumentStreamer.cpp
+
+${OBJECTDIR}/DocumentWriter.o: DocumentWriter.cpp 
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} "$@.d"
+	$(COMPILE.cc) -g -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/DocumentWriter.o DocumentWriter.cpp
+
+${OBJECTDIR}/FdFormatTarget.o: FdFormatTarget.cpp 
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} "$@.d"
+	$(COMPILE.cc) -g -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/FdFormatTarget.o FdFormatTarget.cpp
+
 ${OBJECTDIR}/InputParser.o: InputParser.cpp 
 	${MKDIR} -p ${OBJECTDIR}
 	${RM} "$@.d"
@@ -88,6 +147,31 @@ ${OBJECTDIR}/LocalStr.o: LocalStr.cpp
 	${RM} "$@.d"
 	$(COMPILE.cc) -g -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/LocalStr.o LocalStr.cpp
 
+${OBJECTDIR}/MappedFile.o: MappedFile.cpp 
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} "$@.d"
+	$(COMPILE.cc) -g -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/MappedFile.o MappedFile.cpp
+
+${OBJECTDIR}/NameCache.o: NameCache.cpp 
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} "$@.d"
+	$(COMPILE.cc) -g -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/NameCache.o NameCache.cpp
+
+${OBJECTDIR}/NodeIndex.o: NodeIndex.cpp 
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} "$@.d"
+	$(COMPILE.cc) -g -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/NodeIndex.o NodeIndex.cpp
+
+${OBJECTDIR}/NodePath.o: NodePath.cpp 
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} "$@.d"
+	$(COMPILE.cc) -g -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/NodePath.o NodePath.cpp
+
+${OBJECTDIR}/ScriptPool.o: ScriptPool.cpp 
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} "$@.d"
+	$(COMPILE.cc) -g -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/ScriptPool.o ScriptPool.cpp
+
 ${OBJECTDIR}/XStr.o: XStr.cpp 
 	${MKDIR} -p ${OBJECTDIR}
 	${RM} "$@.d"
@@ -103,6 +187,29 @@ ${OBJECTDIR}/main.o: main.cpp
 	${RM} "$@.d"
 	$(COMPILE.cc) -g -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/main.o main.cpp
 
+# Benchmark suite, built by "make bench": the objects of the program, less
+#	main.o, linked with an entry point of its own
+BENCH_OBJECTFILES= \
+	$(filter-out ${OBJECTDIR}/main.o,${OBJECTFILES}) \
+	${OBJECTDIR}/PipelineBench.o \
+	${OBJECTDIR}/bench_main.o
+
+.bench-conf: ${CND_DISTDIR}/${CND_CONF}/${CND_PLATFORM}/comp-iv-bench
+
+${CND_DISTDIR}/${CND_CONF}/${CND_PLATFORM}/comp-iv-bench: ${BENCH_OBJECTFILES}
+	${MKDIR} -p ${CND_DISTDIR}/${CND_CONF}/${CND_PLATFORM}
+	${LINK.cc} -o ${CND_DISTDIR}/${CND_CONF}/${CND_PLATFORM}/comp-iv-bench ${BENCH_OBJECTFILES} ${LDLIBSOPTIONS}
+
+${OBJECTDIR}/PipelineBench.o: PipelineBench.cpp 
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} "$@.d"
+	$(COMPILE.cc) -g -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/PipelineBench.o PipelineBench.cpp
+
+${OBJECTDIR}/bench_main.o: bench_main.cpp 
+	${MKDIR} -p ${OBJECTDIR}
+	${RM} "$@.d"
+	$(COMPILE.cc) -g -MMD -MP -MF "$@.d" -o ${OBJECTDIR}/bench_main.o bench_main.cpp
+
 # Subprojects
 .build-subprojects:
 
@@ -110,6 +217,7 @@ ${OBJECTDIR}/main.o: main.cpp
 .clean-conf: ${CLEAN_SUBPROJECTS}
 	${RM} -r ${CND_BUILDDIR}/${CND_CONF}
 	${RM} ${CND_DISTDIR}/${CND_CONF}/${CND_PLATFORM}/comp-iv-final-assignment.exe
+	${RM} ${CND_DISTDIR}/${CND_CONF}/${CND_PLATFORM}/comp-iv-bench
 
 # Subprojects
 .clean-subprojects: